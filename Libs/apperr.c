@@ -13,12 +13,13 @@
 #include <string.h>
 #include "apperr.h"
 #include "mmng.h"
+#include "compilerctx.h"
 
 void apperr_runtimeError(char *errMsg)
 {
-  fprintf( stderr, "\033[31;1mInternal runtime error (99):\033[0m %s\n", errMsg);
+  ctx_printError("\033[31;1mInternal runtime error (99):\033[0m %s\n", errMsg);
   mmng_freeAll();
-  exit(internalErr);
+  ctx_raiseError(internalErr);
 }
 
 void apperr_codeError(ErrType type, int row, int col, char *line, char *message, SToken *token)
@@ -26,30 +27,30 @@ void apperr_codeError(ErrType type, int row, int col, char *line, char *message,
   switch (type)
   {
     case lexicalErr:
-      fprintf( stderr, "\033[31;1mLexical error (%d):\033[0m ", type);
+      ctx_printError("\033[31;1mLexical error (%d):\033[0m ", type);
       break;
     case syntaxErr:
-      fprintf( stderr, "\033[31;1mSyntax error (%d):\033[0m ", type);
+      ctx_printError("\033[31;1mSyntax error (%d):\033[0m ", type);
       break;
     case semanticErr:
-      fprintf( stderr, "\033[31;1mSematic error (%d): \033[0m Undefined symbol or invalid definition or redefinition ", type);
+      ctx_printError("\033[31;1mSematic error (%d): \033[0m Undefined symbol or invalid definition or redefinition ", type);
       break;
     case typeCompatibilityErr:
-      fprintf( stderr, "\033[31;1mSematic error (%d):\033[0m type incompatibility ", type);
+      ctx_printError("\033[31;1mSematic error (%d):\033[0m type incompatibility ", type);
       break;
     case anotherSemanticErr:
-      fprintf( stderr, "\033[31;1mSematic error (%d):\033[0m ", type);
+      ctx_printError("\033[31;1mSematic error (%d):\033[0m ", type);
       break;
     default:
       return;
   }
-  fprintf(stderr, "\033[33m%d/%d\033[0m\n", row, col);
+  ctx_printError("\033[33m%d/%d\033[0m\n", row, col);
   if(token != NULL)
-    fprintf(stderr, "Caused by token: \"%s\"\n", grammarToString(token->type));
+    ctx_printError("Caused by token: \"%s\"\n", grammarToString(token->type));
   if (message != NULL)
-    fprintf(stderr, "Error message: %s\n", message);
+    ctx_printError("Error message: %s\n", message);
 
-  fprintf(stderr, " \033[2m% 3d |\033[0m ", row);
+  ctx_printError(" \033[2m% 3d |\033[0m ", row);
   col += 7;
   int consoleRowNum = 0;
 
@@ -61,9 +62,9 @@ void apperr_codeError(ErrType type, int row, int col, char *line, char *message,
     for (; j < 80 && (i + j) < linewidth; j++)
     {
       if (line[i + j] == '\t')
-        fprintf(stderr, "  ");
+        ctx_printError("  ");
       else
-        fprintf(stderr, "%c", line[i + j]);
+        ctx_printError("%c", line[i + j]);
     }
 
     i += j;
@@ -73,12 +74,12 @@ void apperr_codeError(ErrType type, int row, int col, char *line, char *message,
     if(rowFirstCharPosition < col && col < rowFirstCharPosition + 80)
     {
       for(int j = 1; j <= (col-1)%80; j++)
-        fprintf(stderr, " ");
-      fprintf(stderr, "\x1B[31m^\x1B[0m\n");
+        ctx_printError(" ");
+      ctx_printError("\x1B[31m^\x1B[0m\n");
     }
 
     consoleRowNum++;
   }
   mmng_freeAll();
-  exit(type);
+  ctx_raiseError(type);
 }
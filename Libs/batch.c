@@ -0,0 +1,187 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    batch.c
+ * \brief   Batch compilation of many source files
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "batch.h"
+#include "ifjc.h"
+#include "membuf.h"
+
+#define BATCH_MAX_THREADS 256
+#define BATCH_SUFFIX ".ifjcode17"
+
+/**
+ * One input of batch
+ */
+typedef struct {
+  char *srcPath;
+  char *outPath;
+  int result;     /*!< error code of compilation */
+} TBatchInput;
+
+/**
+ * Batch shared by workers
+ */
+typedef struct {
+  TBatchInput *inputs;
+  unsigned inputCnt;
+  unsigned nextInput;     /*!< index of next input to be compiled */
+  pthread_mutex_t lock;   /*!< lock of nextInput */
+  TCompileCache cache;    /*!< cache of compiled programs, NULL for no cache */
+  unsigned maxBuffer;     /*!< limit of code buffer of main scope of every context (ifjc_setMaxBuffer) */
+} TBatch;
+
+// =============================================================================
+// ====================== support functions ====================================
+// =============================================================================
+
+// copy of string
+char *batch_strdup(const char *str, unsigned len)
+{
+  char *copy = mbuf_alloc(NULL, len + 1);
+  memcpy(copy, str, len);
+  copy[len] = '\0';
+  return copy;
+}
+
+// loads list of inputs, returns false if list cannot be read
+bool batch_loadList(const char *listPath, TBatch *batch)
+{
+  TMemBuf list = { NULL, 0, 0 };
+  if (!mbuf_readFile(&list, listPath))
+    return false;
+  unsigned cap = 0;
+  char *line = list.data;
+  while (line != NULL && *line != '\0')
+  {
+    char *lineEnd = strchr(line, '\n');
+    unsigned len = (lineEnd != NULL) ? (unsigned)(lineEnd - line) : strlen(line);
+    while (len > 0 && (line[len - 1] == '\r' || line[len - 1] == ' ' || line[len - 1] == '\t'))
+      len--;
+    if (len > 0)
+    {
+      if (batch->inputCnt == cap)
+      {
+        cap = (cap == 0) ? 64 : cap * 2;
+        batch->inputs = mbuf_alloc(batch->inputs, sizeof(TBatchInput) * cap);
+      }
+      TBatchInput *input = &batch->inputs[batch->inputCnt++];
+      char *separator = memchr(line, ' ', len);
+      unsigned srcLen = (separator != NULL) ? (unsigned)(separator - line) : len;
+      input->srcPath = batch_strdup(line, srcLen);
+      if (separator != NULL)
+        input->outPath = batch_strdup(separator + 1, len - srcLen - 1);
+      else
+      {
+        input->outPath = mbuf_alloc(NULL, srcLen + strlen(BATCH_SUFFIX) + 1);
+        sprintf(input->outPath, "%s%s", input->srcPath, BATCH_SUFFIX);
+      }
+      input->result = 0;
+    }
+    line = (lineEnd != NULL) ? lineEnd + 1 : NULL;
+  }
+  mbuf_free(&list);
+  return true;
+}
+
+// worker thread, compiles inputs until all are taken
+void *batch_worker(void *arg)
+{
+  TBatch *batch = arg;
+  TCompilerCtx ctx = ifjc_createCtx();
+  TMemBuf src = { NULL, 0, 0 };
+  TMemBuf code = { NULL, 0, 0 };
+  if (ctx == NULL)
+    mbuf_alloc(NULL, (size_t)-1); // reports allocation error
+  ifjc_setMaxBuffer(ctx, batch->maxBuffer);
+
+  while (true)
+  {
+    pthread_mutex_lock(&batch->lock);
+    unsigned index = batch->nextInput++;
+    pthread_mutex_unlock(&batch->lock);
+    if (index >= batch->inputCnt)
+      break;
+
+    TBatchInput *input = &batch->inputs[index];
+    if (!mbuf_readFile(&src, input->srcPath))
+    {
+      fprintf(stderr, "%s: cannot be read\n", input->srcPath);
+      input->result = 99;
+      continue;
+    }
+    code.len = 0;
+    input->result = cache_compile(batch->cache, ctx, src.data, src.len, mbuf_output, &code);
+    if (input->result != 0)
+      fprintf(stderr, "%s: compilation failed with error %d\n", input->srcPath, input->result);
+    else if (!mbuf_writeFile(&code, input->outPath))
+    {
+      fprintf(stderr, "%s: cannot be written\n", input->outPath);
+      input->result = 99;
+    }
+  }
+
+  mbuf_free(&src);
+  mbuf_free(&code);
+  ifjc_destroyCtx(ctx);
+  return NULL;
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+int batch_run(const char *listPath, unsigned threadCnt, unsigned maxBuffer, TCompileCache cache)
+{
+  TBatch batch = { NULL, 0, 0, PTHREAD_MUTEX_INITIALIZER, cache, maxBuffer };
+  if (!batch_loadList(listPath, &batch))
+  {
+    fprintf(stderr, "%s: list of inputs cannot be read\n", listPath);
+    return 99;
+  }
+
+  if (threadCnt == 0)
+  {
+    long cpuCnt = sysconf(_SC_NPROCESSORS_ONLN);
+    threadCnt = (cpuCnt > 0) ? (unsigned)cpuCnt : 1;
+  }
+  if (threadCnt > batch.inputCnt)
+    threadCnt = batch.inputCnt;
+  if (threadCnt > BATCH_MAX_THREADS)
+    threadCnt = BATCH_MAX_THREADS;
+
+  pthread_t threads[BATCH_MAX_THREADS];
+  unsigned startedCnt = 0;
+  for (unsigned i = 0; i < threadCnt; i++)
+    if (pthread_create(&threads[startedCnt], NULL, batch_worker, &batch) == 0)
+      startedCnt++;
+  if (startedCnt == 0 && batch.inputCnt > 0)
+    batch_worker(&batch); // no thread can be created, batch is compiled by this thread
+  for (unsigned i = 0; i < startedCnt; i++)
+    pthread_join(threads[i], NULL);
+
+  int result = 0;
+  for (unsigned i = 0; i < batch.inputCnt; i++)
+  {
+    if (result == 0)
+      result = batch.inputs[i].result;
+    free(batch.inputs[i].srcPath);
+    free(batch.inputs[i].outPath);
+  }
+  free(batch.inputs);
+  pthread_mutex_destroy(&batch.lock);
+  return result;
+}
@@ -0,0 +1,36 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    batch.h
+ * \brief   Batch compilation of many source files
+ *
+ * Package compiles list of source files inside one process by pool of worker threads. Every worker
+ * has its own compiler context (with its own memory manager) and its own buffers of source and
+ * generated code, so workers share only index of next input in list.
+ *
+ * List is text file with one input on every line: path of source file optionally followed by space
+ * and path of output file. Default output file is path of source file with suffix ".ifjcode17".
+ * Output file is written only if compilation succeeds, errors are reported on standard error output.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _Batch
+#define _Batch
+
+#include "cache.h"
+
+/**
+ * Compiles all inputs of list
+ *
+ * \param listPath path of list of inputs
+ * \param threadCnt count of worker threads, 0 for count of online processors
+ * \param maxBuffer limit of code buffer of main scope in bytes (ifjc_setMaxBuffer), 0 for no limit
+ * \param cache cache of compiled programs shared by workers, NULL for no cache
+ * \returns 0 if all inputs were compiled, otherwise error code of first failed input in list
+ */
+int batch_run(const char *listPath, unsigned threadCnt, unsigned maxBuffer, TCompileCache cache);
+
+#endif // _Batch
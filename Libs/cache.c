@@ -0,0 +1,307 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    cache.c
+ * \brief   Content addressed cache of compiled programs
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "cache.h"
+
+#define CACHE_SUFFIX ".ifjcode17"
+#define CACHE_TEMP_SUFFIX CACHE_SUFFIX ".tmp" // temporary file of entry being written (mbuf_writeFile)
+#define CACHE_KEY_LEN 32              // hexadecimal digits of key
+#define CACHE_TEMP_AGE 600            // seconds after which temporary file is left by crashed writer
+#define CACHE_MAX_HEADER (IFJC_MAX_FINGERPRINT + 48) // fingerprint, lengths and hash of code
+#define CACHE_EVICT_TARGET(max) ((max) / 10 * 9) // eviction frees space for more entries at once
+
+/**
+ * Cache of compiled programs
+ */
+struct CompileCache {
+  char *dir;
+  unsigned long long maxSize;
+  unsigned long long size;    /*!< estimated size of entries, it is recounted on eviction */
+  pthread_mutex_t lock;       /*!< lock of size and eviction */
+};
+
+/**
+ * Entry of directory considered on eviction
+ */
+typedef struct {
+  char *path;
+  unsigned long long size;
+  struct timespec usedAt;
+} TCacheEntry;
+
+// =============================================================================
+// ====================== support functions ====================================
+// =============================================================================
+
+// FNV-1a hash of memory block continuing from hash value
+uint64_t cache_hashBytes(uint64_t hash, const void *bytes, size_t len)
+{
+  const unsigned char *actByte = bytes;
+  for (size_t i = 0; i < len; i++)
+  {
+    hash ^= actByte[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// final mixing of hash, so both halves of key are independent
+uint64_t cache_mix(uint64_t hash)
+{
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// path of entry of source code compiled by context, memory is allocated here and free has to be called
+char *cache_entryPath(TCompileCache cache, TCompilerCtx ctx, const char *src, unsigned len)
+{
+  char fingerprint[IFJC_MAX_FINGERPRINT];
+  ifjc_fingerprint(ctx, fingerprint);
+  uint64_t low = cache_hashBytes(14695981039346656037ull, fingerprint, strlen(fingerprint) + 1);
+  uint64_t high = cache_hashBytes(low ^ 0x9e3779b97f4a7c15ull, &len, sizeof(len));
+  low = cache_mix(cache_hashBytes(low, src, len));
+  high = cache_mix(cache_hashBytes(high, src, len));
+
+  char *path = mbuf_alloc(NULL, strlen(cache->dir) + CACHE_KEY_LEN + strlen(CACHE_SUFFIX) + 2);
+  sprintf(path, "%s/%016llx%016llx%s", cache->dir, (unsigned long long)high, (unsigned long long)low, CACHE_SUFFIX);
+  return path;
+}
+
+// returns true if name of file is name of entry
+bool cache_isEntry(const char *name)
+{
+  size_t len = strlen(name);
+  return len == CACHE_KEY_LEN + strlen(CACHE_SUFFIX)
+    && strspn(name, "0123456789abcdef") == CACHE_KEY_LEN
+    && strcmp(name + CACHE_KEY_LEN, CACHE_SUFFIX) == 0;
+}
+
+// returns true if name of file is name of temporary file of entry
+bool cache_isTemp(const char *name)
+{
+  return strspn(name, "0123456789abcdef") == CACHE_KEY_LEN &&
+    strncmp(name + CACHE_KEY_LEN, CACHE_TEMP_SUFFIX, strlen(CACHE_TEMP_SUFFIX)) == 0;
+}
+
+int cache_compareEntries(const void *a, const void *b)
+{
+  const struct timespec *timeA = &((const TCacheEntry *)a)->usedAt;
+  const struct timespec *timeB = &((const TCacheEntry *)b)->usedAt;
+  if (timeA->tv_sec != timeB->tv_sec)
+    return (timeA->tv_sec < timeB->tv_sec) ? -1 : 1;
+  return (timeA->tv_nsec > timeB->tv_nsec) - (timeA->tv_nsec < timeB->tv_nsec);
+}
+
+/**
+ * Lists entries of directory and returns their size, if evict is true, least recently used entries
+ * are removed until size of cache drops under target of eviction
+ * Temporary files older than CACHE_TEMP_AGE are removed, others are counted to size.
+ */
+unsigned long long cache_scan(TCompileCache cache, bool evict)
+{
+  DIR *dir = opendir(cache->dir);
+  if (dir == NULL)
+    return 0;
+  TCacheEntry *entries = NULL;
+  unsigned entryCnt = 0;
+  unsigned entryCap = 0;
+  unsigned long long size = 0;
+  time_t now = time(NULL);
+  struct dirent *dirEntry;
+  while ((dirEntry = readdir(dir)) != NULL)
+  {
+    bool isTemp = cache_isTemp(dirEntry->d_name);
+    if (!isTemp && !cache_isEntry(dirEntry->d_name))
+      continue;
+    char *path = mbuf_alloc(NULL, strlen(cache->dir) + strlen(dirEntry->d_name) + 2);
+    sprintf(path, "%s/%s", cache->dir, dirEntry->d_name);
+    struct stat info;
+    if (stat(path, &info) != 0)
+    {
+      free(path); // entry removed by other process meanwhile
+      continue;
+    }
+    if (isTemp)
+    {
+      // file of running writer is renamed to entry soon, file of crashed writer is never renamed
+      if (now - info.st_mtim.tv_sec > CACHE_TEMP_AGE)
+        remove(path);
+      else
+        size += info.st_size;
+      free(path);
+      continue;
+    }
+    if (entryCnt == entryCap)
+    {
+      entryCap = (entryCap == 0) ? 64 : entryCap * 2;
+      entries = mbuf_alloc(entries, sizeof(TCacheEntry) * entryCap);
+    }
+    entries[entryCnt].path = path;
+    entries[entryCnt].size = info.st_size;
+    entries[entryCnt].usedAt = info.st_mtim;
+    entryCnt++;
+    size += info.st_size;
+  }
+  closedir(dir);
+
+  if (evict)
+  {
+    qsort(entries, entryCnt, sizeof(TCacheEntry), cache_compareEntries);
+    for (unsigned i = 0; i < entryCnt && size > CACHE_EVICT_TARGET(cache->maxSize); i++)
+    {
+      // entry opened by reader stays readable until it is closed
+      if (remove(entries[i].path) == 0 || errno == ENOENT)
+        size -= entries[i].size;
+    }
+  }
+  for (unsigned i = 0; i < entryCnt; i++)
+    free(entries[i].path);
+  free(entries);
+  return size;
+}
+
+// header of entry, it is followed by source and generated code
+void cache_printHeader(char *header, TCompilerCtx ctx, unsigned srcLen, const char *code, unsigned codeLen)
+{
+  char fingerprint[IFJC_MAX_FINGERPRINT];
+  ifjc_fingerprint(ctx, fingerprint);
+  unsigned long long codeHash = cache_hashBytes(14695981039346656037ull, code, codeLen);
+  sprintf(header, "%s\n%u %u %016llx\n", fingerprint, srcLen, codeLen, codeHash);
+}
+
+/**
+ * Streams code of entry to output, returns false if there is no entry
+ * Entry which cannot be read whole, which does not hold the same fingerprint and source (collision of keys)
+ * or whose code does not match its hash (corrupted file) is a miss.
+ */
+bool cache_load(const char *path, TCompilerCtx ctx, const char *src, unsigned len, TIfjcOutput output,
+                void *userData)
+{
+  TMemBuf entry = { NULL, 0, 0 };
+  if (!mbuf_readFile(&entry, path))
+  {
+    mbuf_free(&entry);
+    return false;
+  }
+  // header written on store is expected, length of code is read from it and code is in the rest of entry
+  unsigned codeLen = 0;
+  char *lengths = strchr(entry.data, '\n');
+  if (lengths != NULL)
+    sscanf(lengths + 1, "%*u %u", &codeLen);
+  const char *code = entry.data + ((entry.len > codeLen) ? entry.len - codeLen : 0);
+  char header[CACHE_MAX_HEADER];
+  cache_printHeader(header, ctx, len, code, (entry.len > codeLen) ? codeLen : 0);
+  unsigned headerLen = strlen(header);
+  bool isHit = entry.len == (unsigned long long)headerLen + len + codeLen &&
+    memcmp(entry.data, header, headerLen) == 0 && memcmp(entry.data + headerLen, src, len) == 0;
+  if (isHit)
+  {
+    utimensat(AT_FDCWD, path, NULL, 0); // entry is used now
+    if (output == NULL)
+      fwrite(code, sizeof(char), codeLen, stdout);
+    else
+      output(code, codeLen, userData);
+  }
+  mbuf_free(&entry);
+  return isHit;
+}
+
+// stores code as entry and evicts old entries when cache is full
+void cache_store(TCompileCache cache, const char *path, TCompilerCtx ctx, const char *src, unsigned len,
+                 TMemBuf *code)
+{
+  char header[CACHE_MAX_HEADER];
+  cache_printHeader(header, ctx, len, code->data, code->len);
+  TMemBuf entry = { NULL, 0, 0 };
+  mbuf_append(&entry, header, strlen(header));
+  mbuf_append(&entry, src, len);
+  mbuf_append(&entry, code->data, code->len);
+  bool isStored = entry.len <= cache->maxSize && mbuf_writeFile(&entry, path);
+  unsigned entryLen = entry.len;
+  mbuf_free(&entry);
+  if (!isStored)
+    return; // program is compiled anyway, cache is only not filled
+
+  pthread_mutex_lock(&cache->lock);
+  cache->size += entryLen;
+  if (cache->size > cache->maxSize)
+    cache->size = cache_scan(cache, true);
+  pthread_mutex_unlock(&cache->lock);
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+TCompileCache cache_open(const char *dir, unsigned long long maxSize)
+{
+  struct stat info;
+  if (mkdir(dir, 0777) != 0 && (errno != EEXIST || stat(dir, &info) != 0 || !S_ISDIR(info.st_mode)))
+    return NULL;
+  TCompileCache cache = mbuf_alloc(NULL, sizeof(struct CompileCache));
+  cache->dir = mbuf_alloc(NULL, strlen(dir) + 1);
+  strcpy(cache->dir, dir);
+  cache->maxSize = maxSize;
+  pthread_mutex_init(&cache->lock, NULL);
+  cache->size = cache_scan(cache, false);
+  return cache;
+}
+
+int cache_compile(TCompileCache cache, TCompilerCtx ctx, const char *src, unsigned len, TIfjcOutput output, void *userData)
+{
+  if (cache == NULL)
+    return ifjc_compile(ctx, src, len, output, userData);
+
+  char *path = cache_entryPath(cache, ctx, src, len);
+  int result = 0;
+  if (!cache_load(path, ctx, src, len, output, userData))
+  {
+    // code is buffered, it is stored and passed to output only when compilation succeeds
+    TMemBuf code = { NULL, 0, 0 };
+    mbuf_append(&code, "", 0);
+    result = ifjc_compile(ctx, src, len, mbuf_output, &code);
+    if (result == 0)
+    {
+      cache_store(cache, path, ctx, src, len, &code);
+      if (output == NULL)
+        fwrite(code.data, sizeof(char), code.len, stdout);
+      else
+        output(code.data, code.len, userData);
+    }
+    mbuf_free(&code);
+  }
+  free(path);
+  return result;
+}
+
+void cache_close(TCompileCache cache)
+{
+  if (cache == NULL)
+    return;
+  pthread_mutex_destroy(&cache->lock);
+  free(cache->dir);
+  free(cache);
+}
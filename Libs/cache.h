@@ -0,0 +1,69 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    cache.h
+ * \brief   Content addressed cache of compiled programs
+ *
+ * Cache stores generated code of successful compilations in local directory. Entry is named by
+ * 128 bit hash of source code and fingerprint of generated code (ifjc_fingerprint: version and sources
+ * of compiler and settings of context affecting generated code), so unchanged source is never scanned,
+ * parsed or generated again, its code is just streamed from file. Entry holds also fingerprint and
+ * source itself, they are compared on load, so collision of keys or corrupted entry is only a miss.
+ *
+ * Entries are written atomically (temporary file renamed to name of entry), so cache can be shared
+ * by worker threads of batch and by more processes. Size of directory is bounded, when it is
+ * exceeded least recently used entries are removed (time of use is modification time of entry,
+ * which is updated on every hit). Temporary files left by crashed writers are removed on eviction.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _Cache
+#define _Cache
+
+#include "ifjc.h"
+#include "membuf.h"
+
+/**
+ * Default limit of size of cache directory in bytes
+ */
+#define CACHE_DEFAULT_SIZE (256ull * 1024ull * 1024ull)
+
+/**
+ * Cache of compiled programs
+ */
+typedef struct CompileCache *TCompileCache;
+
+/**
+ * Opens cache in directory, directory is created if it does not exist
+ *
+ * \param dir path of cache directory
+ * \param maxSize maximal size of all entries in bytes
+ * \returns cache or NULL if directory cannot be used
+ */
+TCompileCache cache_open(const char *dir, unsigned long long maxSize);
+
+/**
+ * Compiles program through cache
+ *
+ * Code of cached program is streamed to output right away, otherwise program is compiled by context
+ * and on success its code is stored to cache. Cache can be used by more threads at once.
+ *
+ * \param cache cache, NULL to compile without cache
+ * \param ctx compiler context used on cache miss
+ * \param src source code
+ * \param len length of source code
+ * \param output output of generated code, NULL to write it to standard output
+ * \param userData user data passed to output
+ * \returns 0 on success, otherwise error code of compilation (ErrType)
+ */
+int cache_compile(TCompileCache cache, TCompilerCtx ctx, const char *src, unsigned len, TIfjcOutput output, void *userData);
+
+/**
+ * Closes cache, entries stay in directory
+ */
+void cache_close(TCompileCache cache);
+
+#endif // _Cache
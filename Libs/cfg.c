@@ -0,0 +1,535 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    cfg.c
+ * \brief   Control flow graph of generated code
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "cfg.h"
+#include "codebuf.h"
+#include "mmng.h"
+#include "apperr.h"
+#include "utils.h"
+
+#define CFG_CHUNK 16
+#define CFG_ROTATE_MAX 8 // maximal count of instructions of loop condition copied to end of loop
+
+/**
+ * Label found in code
+ */
+typedef struct {
+  const char *text;
+  unsigned len;
+  int block;
+} TCfgLabel;
+
+// =============================================================================
+// ====================== support functions ====================================
+// =============================================================================
+
+// true if instruction begins with operation code
+bool cfg_isOpcode(const char *text, unsigned len, const char *opcode)
+{
+  unsigned opLen = strlen(opcode);
+  return len >= opLen && strncmp(text, opcode, opLen) == 0 && (len == opLen || text[opLen] == ' ');
+}
+
+// creates new empty block on the end of graph
+TCfgBlock cfg_newBlock(TCfg cfg)
+{
+  if (cfg->blockCnt == cfg->blockCap)
+  {
+    cfg->blockCap += CFG_CHUNK;
+    cfg->blocks = mmng_safeRealloc(cfg->blocks, sizeof(TCfgBlock) * cfg->blockCap);
+  }
+  TCfgBlock block = mmng_safeMalloc(sizeof(struct CfgBlock));
+  block->index = cfg->blockCnt;
+  block->label = NULL;
+  block->labelLen = 0;
+  block->ownLabel = NULL;
+  block->instrs = NULL;
+  block->instrCnt = 0;
+  block->instrCap = 0;
+  block->exit = cfgFall;
+  block->isEqCond = false;
+  block->condOperands.text = NULL;
+  block->condOperands.len = 0;
+  block->jumpTarget = -1;
+  block->extTarget.text = NULL;
+  block->extTarget.len = 0;
+  block->fallTarget = -1;
+  block->preds = NULL;
+  block->predCnt = 0;
+  block->isReachable = false;
+  cfg->blocks[cfg->blockCnt++] = block;
+  return block;
+}
+
+// appends instruction to block
+void cfg_addInstr(TCfgBlock block, const char *text, unsigned len)
+{
+  if (block->instrCnt == block->instrCap)
+  {
+    block->instrCap += CFG_CHUNK;
+    block->instrs = mmng_safeRealloc(block->instrs, sizeof(TCfgInstr) * block->instrCap);
+  }
+  block->instrs[block->instrCnt].text = text;
+  block->instrs[block->instrCnt].len = len;
+  block->instrCnt++;
+}
+
+// finds block of label, -1 if label is not in code
+int cfg_findLabel(TCfgLabel *labels, int labelCnt, const char *text, unsigned len)
+{
+  for (int i = 0; i < labelCnt; i++)
+    if (labels[i].len == len && strncmp(labels[i].text, text, len) == 0)
+      return labels[i].block;
+  return -1;
+}
+
+// adds predecessor to block
+void cfg_addPred(TCfgBlock block, int pred)
+{
+  if (block->predCnt % CFG_CHUNK == 0)
+    block->preds = mmng_safeRealloc(block->preds, sizeof(int) * (block->predCnt + CFG_CHUNK));
+  block->preds[block->predCnt++] = pred;
+}
+
+// final destination of control flow going to block
+int cfg_finalTarget(TCfg cfg, int target)
+{
+  for (int steps = 0; target >= 0 && steps < cfg->blockCnt; steps++)
+  {
+    TCfgBlock block = cfg->blocks[target];
+    if (block->instrCnt > 0)
+      break;
+    if (block->exit == cfgJump && block->jumpTarget >= 0)
+      target = block->jumpTarget;
+    else if (block->exit == cfgFall)
+      target = block->fallTarget;
+    else
+      break;
+  }
+  return target;
+}
+
+// true if block which is not placed yet falls to target
+bool cfg_hasUnplacedFallPred(TCfg cfg, bool *placed, int target)
+{
+  for (int i = 0; i < cfg->blockCnt; i++)
+  {
+    TCfgBlock block = cfg->blocks[i];
+    if (i != target && !placed[i] && block->isReachable &&
+        (block->exit == cfgFall || block->exit == cfgCond) && block->fallTarget == target)
+      return true;
+  }
+  return false;
+}
+
+// appends line of instruction from parts to output
+void cfg_printInstr(TCodeBuf *out, const char *opcode, TCfgBlock target, TCfgInstr *label, TCfgInstr *operands)
+{
+  cbuf_print(out, opcode, strlen(opcode));
+  if (target != NULL)
+  {
+    cbuf_print(out, " ", 1);
+    cbuf_print(out, target->label, target->labelLen);
+  }
+  else if (label != NULL)
+  {
+    cbuf_print(out, " ", 1);
+    cbuf_print(out, label->text, label->len);
+  }
+  if (operands != NULL)
+  {
+    cbuf_print(out, " ", 1);
+    cbuf_print(out, operands->text, operands->len);
+  }
+  cbuf_print(out, "\n", 1);
+}
+
+// gives name to block which is target of jump, name is unique inside of function
+void cfg_requireLabel(TCfg cfg, TCfgBlock block)
+{
+  if (block->label != NULL)
+    return;
+  block->ownLabel = mmng_safeMalloc(sizeof(char) * (strlen(cfg->labelPrefix) + 16));
+  sprintf(block->ownLabel, "%s$cfg%u", cfg->labelPrefix, cfg->labelCnt++);
+  block->label = block->ownLabel;
+  block->labelLen = strlen(block->ownLabel);
+}
+
+/**
+ * Loop rotation: block ending with jump back to short conditional block (condition of loop)
+ * gets copy of its instructions and conditional jump, so one jump per iteration is saved.
+ */
+void cfg_rotateLoop(TCfg cfg, TCfgBlock block)
+{
+  TCfgBlock cond = cfg->blocks[block->jumpTarget];
+  if (cond == block || cond->exit != cfgCond || cond->instrCnt > CFG_ROTATE_MAX)
+    return;
+  for (int i = 0; i < cond->instrCnt; i++)
+    cfg_addInstr(block, cond->instrs[i].text, cond->instrs[i].len);
+  block->exit = cfgCond;
+  block->isEqCond = cond->isEqCond;
+  block->condOperands = cond->condOperands;
+  block->jumpTarget = cond->jumpTarget;
+  block->extTarget = cond->extTarget;
+  block->fallTarget = cond->fallTarget;
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+// Builds control flow graph from code
+TCfg cfg_build(const char *code, const char *labelPrefix)
+{
+  TCfg cfg = mmng_safeMalloc(sizeof(struct Cfg));
+  cfg->code = util_StrHardCopy(code);
+  cfg->labelPrefix = labelPrefix;
+  cfg->labelCnt = 0;
+  cfg->blocks = NULL;
+  cfg->blockCnt = 0;
+  cfg->blockCap = 0;
+
+  TCfgLabel *labels = NULL;
+  int labelCnt = 0;
+  TCfgInstr *jumpLabels = NULL; // label of final jump of every block
+  int jumpLabelCap = 0;
+
+  // split code into blocks
+  TCfgBlock block = cfg_newBlock(cfg);
+  bool isClosed = false; // block ended by jump or return, next instruction starts new block
+  const char *actCode = cfg->code;
+  TCodeLine line;
+  while (cbuf_nextLine(&actCode, &line))
+  {
+    const char *actLine = line.text;
+    unsigned len = line.len;
+    const char *lineEnd = actLine + len;
+
+    if (cfg_isOpcode(actLine, len, "LABEL"))
+    {
+      // label always starts block, following labels are aliases of the same block
+      if (isClosed || block->instrCnt > 0)
+      {
+        block = cfg_newBlock(cfg);
+        isClosed = false;
+      }
+      if (labelCnt % CFG_CHUNK == 0)
+        labels = mmng_safeRealloc(labels, sizeof(TCfgLabel) * (labelCnt + CFG_CHUNK));
+      labels[labelCnt].text = actLine + 6;
+      labels[labelCnt].len = len - 6;
+      labels[labelCnt].block = block->index;
+      labelCnt++;
+      if (block->label == NULL)
+      {
+        block->label = actLine + 6;
+        block->labelLen = len - 6;
+      }
+      continue;
+    }
+
+    if (isClosed)
+    {
+      block = cfg_newBlock(cfg);
+      isClosed = false;
+    }
+
+    if (cfg_isOpcode(actLine, len, "JUMP") || cfg_isOpcode(actLine, len, "JUMPIFEQ") ||
+        cfg_isOpcode(actLine, len, "JUMPIFNEQ"))
+    {
+      const char *label = strchr(actLine, ' ') + 1;
+      const char *labelEnd = memchr(label, ' ', lineEnd - label);
+      if (labelEnd == NULL)
+        labelEnd = lineEnd;
+      if (actLine[4] == ' ')
+        block->exit = cfgJump;
+      else
+      {
+        block->exit = cfgCond;
+        block->isEqCond = actLine[6] == 'E';
+        block->condOperands.text = labelEnd + 1;
+        block->condOperands.len = lineEnd - labelEnd - 1;
+      }
+      while (block->index >= jumpLabelCap)
+      {
+        jumpLabelCap += CFG_CHUNK;
+        jumpLabels = mmng_safeRealloc(jumpLabels, sizeof(TCfgInstr) * jumpLabelCap);
+      }
+      jumpLabels[block->index].text = label;
+      jumpLabels[block->index].len = labelEnd - label;
+      isClosed = true;
+    }
+    else
+    {
+      cfg_addInstr(block, actLine, len);
+      if (cfg_isOpcode(actLine, len, "RETURN"))
+      {
+        block->exit = cfgEnd;
+        isClosed = true;
+      }
+    }
+  }
+  // empty block representing end of code
+  cfg_newBlock(cfg)->exit = cfgEnd;
+
+  // connect blocks
+  for (int i = 0; i < cfg->blockCnt; i++)
+  {
+    block = cfg->blocks[i];
+    if (block->exit == cfgFall || block->exit == cfgCond)
+      block->fallTarget = i + 1;
+    if (block->exit == cfgJump || block->exit == cfgCond)
+    {
+      block->jumpTarget = cfg_findLabel(labels, labelCnt, jumpLabels[i].text, jumpLabels[i].len);
+      if (block->jumpTarget < 0)
+        block->extTarget = jumpLabels[i];
+    }
+  }
+
+  if (labels != NULL)
+    mmng_safeFree(labels);
+  if (jumpLabels != NULL)
+    mmng_safeFree(jumpLabels);
+  return cfg;
+}
+
+// Frees graph
+void cfg_destroy(TCfg cfg)
+{
+  if (cfg == NULL)
+    return;
+  for (int i = 0; i < cfg->blockCnt; i++)
+  {
+    TCfgBlock block = cfg->blocks[i];
+    if (block->instrs != NULL)
+      mmng_safeFree(block->instrs);
+    if (block->preds != NULL)
+      mmng_safeFree(block->preds);
+    if (block->ownLabel != NULL)
+      mmng_safeFree(block->ownLabel);
+    mmng_safeFree(block);
+  }
+  if (cfg->blocks != NULL)
+    mmng_safeFree(cfg->blocks);
+  mmng_safeFree(cfg->code);
+  mmng_safeFree(cfg);
+}
+
+// Redirects jumps and falls leading to empty blocks right to their final destination
+void cfg_threadJumps(TCfg cfg)
+{
+  for (int i = 0; i < cfg->blockCnt; i++)
+  {
+    TCfgBlock block = cfg->blocks[i];
+    if (block->exit == cfgJump || block->exit == cfgCond)
+      block->jumpTarget = cfg_finalTarget(cfg, block->jumpTarget);
+    if (block->exit == cfgFall || block->exit == cfgCond)
+      block->fallTarget = cfg_finalTarget(cfg, block->fallTarget);
+    // both ways of condition leads to the same block
+    if (block->exit == cfgCond && block->jumpTarget >= 0 && block->jumpTarget == block->fallTarget)
+      block->exit = cfgFall;
+  }
+}
+
+// Marks blocks reachable from entry and computes predecessors of reachable blocks
+void cfg_computeReachability(TCfg cfg)
+{
+  int *stack = mmng_safeMalloc(sizeof(int) * (cfg->blockCnt + 1));
+  int stackCnt = 0;
+  for (int i = 0; i < cfg->blockCnt; i++)
+  {
+    cfg->blocks[i]->isReachable = false;
+    cfg->blocks[i]->predCnt = 0;
+  }
+  cfg->blocks[0]->isReachable = true;
+  stack[stackCnt++] = 0;
+  while (stackCnt > 0)
+  {
+    TCfgBlock block = cfg->blocks[stack[--stackCnt]];
+    int succs[2] = { -1, -1 };
+    if (block->exit == cfgJump || block->exit == cfgCond)
+      succs[0] = block->jumpTarget;
+    if (block->exit == cfgFall || block->exit == cfgCond)
+      succs[1] = block->fallTarget;
+    for (int i = 0; i < 2; i++)
+    {
+      if (succs[i] < 0)
+        continue;
+      TCfgBlock succ = cfg->blocks[succs[i]];
+      cfg_addPred(succ, block->index);
+      if (!succ->isReachable)
+      {
+        succ->isReachable = true;
+        stack[stackCnt++] = succ->index;
+      }
+    }
+  }
+  mmng_safeFree(stack);
+}
+
+// Lays out reachable blocks and prints them to code
+char *cfg_toCode(TCfg cfg)
+{
+  bool *placed = mmng_safeMalloc(sizeof(bool) * cfg->blockCnt);
+  int *order = mmng_safeMalloc(sizeof(int) * cfg->blockCnt);
+  int orderCnt = 0;
+  for (int i = 0; i < cfg->blockCnt; i++)
+    placed[i] = false;
+
+  // chains of blocks where every block is followed by its successor, end of code is always last
+  int endBlock = cfg->blockCnt - 1;
+  for (int i = 0; i < endBlock; i++)
+  {
+    int actBlock = i;
+    while (actBlock >= 0 && actBlock != endBlock && !placed[actBlock] && cfg->blocks[actBlock]->isReachable)
+    {
+      TCfgBlock block = cfg->blocks[actBlock];
+      placed[actBlock] = true;
+      order[orderCnt++] = actBlock;
+      if (block->exit == cfgJump && block->jumpTarget >= 0 &&
+          (placed[block->jumpTarget] || cfg_hasUnplacedFallPred(cfg, placed, block->jumpTarget)))
+        cfg_rotateLoop(cfg, block);
+
+      actBlock = -1;
+      if (block->exit == cfgFall)
+        actBlock = block->fallTarget;
+      else if (block->exit == cfgCond)
+      {
+        if (!placed[block->fallTarget] && !cfg_hasUnplacedFallPred(cfg, placed, block->fallTarget))
+          actBlock = block->fallTarget;
+        else if (block->jumpTarget >= 0 && !cfg_hasUnplacedFallPred(cfg, placed, block->jumpTarget))
+          actBlock = block->jumpTarget; // condition is inverted
+      }
+      else if (block->exit == cfgJump && block->jumpTarget >= 0 &&
+          !cfg_hasUnplacedFallPred(cfg, placed, block->jumpTarget))
+        actBlock = block->jumpTarget;
+    }
+  }
+  if (cfg->blocks[endBlock]->isReachable)
+    order[orderCnt++] = endBlock;
+
+  // jumps of laid out blocks, -1 when control continues to next block
+  int *jumps = mmng_safeMalloc(sizeof(int) * cfg->blockCnt * 2);
+  for (int k = 0; k < orderCnt; k++)
+  {
+    TCfgBlock block = cfg->blocks[order[k]];
+    int next = (k + 1 < orderCnt) ? order[k + 1] : -1;
+    int *actJumps = &jumps[order[k] * 2];
+    actJumps[0] = -1; // conditional or unconditional jump
+    actJumps[1] = -1; // unconditional jump after conditional one
+    switch (block->exit)
+    {
+      case cfgFall:
+        if (block->fallTarget != next)
+          actJumps[0] = block->fallTarget;
+        break;
+      case cfgJump:
+        if (block->jumpTarget != next && block->jumpTarget >= 0)
+          actJumps[0] = block->jumpTarget;
+        break;
+      case cfgCond:
+        if (block->fallTarget == next || block->jumpTarget < 0)
+        {
+          actJumps[0] = block->jumpTarget;
+          if (block->fallTarget != next)
+            actJumps[1] = block->fallTarget;
+        }
+        else if (block->jumpTarget == next)
+        {
+          // inverted condition jumps to fall target
+          block->isEqCond = !block->isEqCond;
+          actJumps[0] = block->fallTarget;
+          block->fallTarget = block->jumpTarget;
+        }
+        else
+        {
+          actJumps[0] = block->jumpTarget;
+          actJumps[1] = block->fallTarget;
+        }
+        break;
+      default:
+        break;
+    }
+    for (int j = 0; j < 2; j++)
+      if (actJumps[j] >= 0)
+        cfg_requireLabel(cfg, cfg->blocks[actJumps[j]]);
+  }
+
+  // only labels used by some jump are printed
+  bool *isUsed = placed;
+  for (int i = 0; i < cfg->blockCnt; i++)
+    isUsed[i] = false;
+  for (int k = 0; k < orderCnt; k++)
+    for (int j = 0; j < 2; j++)
+      if (jumps[order[k] * 2 + j] >= 0)
+        isUsed[jumps[order[k] * 2 + j]] = true;
+
+  TCodeBuf out = { NULL, 0, 0 };
+  cbuf_print(&out, "", 0);
+  for (int k = 0; k < orderCnt; k++)
+  {
+    TCfgBlock block = cfg->blocks[order[k]];
+    int *actJumps = &jumps[order[k] * 2];
+    if (isUsed[block->index])
+    {
+      cbuf_print(&out, "LABEL ", 6);
+      cbuf_print(&out, block->label, block->labelLen);
+      cbuf_print(&out, "\n", 1);
+    }
+    for (int i = 0; i < block->instrCnt; i++)
+    {
+      // second creation of frame right after another one (blocks joined without label) does nothing
+      if (block->instrs[i].len == 11 && strncmp(block->instrs[i].text, "CREATEFRAME", 11) == 0 &&
+          out.len >= 12 && strcmp(&out.text[out.len - 12], "CREATEFRAME\n") == 0 &&
+          (out.len == 12 || out.text[out.len - 13] == '\n'))
+        continue;
+      cbuf_print(&out, block->instrs[i].text, block->instrs[i].len);
+      cbuf_print(&out, "\n", 1);
+    }
+    switch (block->exit)
+    {
+      case cfgFall:
+        if (actJumps[0] >= 0)
+          cfg_printInstr(&out, "JUMP", cfg->blocks[actJumps[0]], NULL, NULL);
+        break;
+      case cfgJump:
+        if (block->jumpTarget < 0)
+          cfg_printInstr(&out, "JUMP", NULL, &block->extTarget, NULL);
+        else if (actJumps[0] >= 0)
+          cfg_printInstr(&out, "JUMP", cfg->blocks[actJumps[0]], NULL, NULL);
+        break;
+      case cfgCond:
+        cfg_printInstr(&out, block->isEqCond ? "JUMPIFEQ" : "JUMPIFNEQ",
+          (actJumps[0] >= 0) ? cfg->blocks[actJumps[0]] : NULL, &block->extTarget, &block->condOperands);
+        if (actJumps[1] >= 0)
+          cfg_printInstr(&out, "JUMP", cfg->blocks[actJumps[1]], NULL, NULL);
+        break;
+      default:
+        break;
+    }
+  }
+
+  mmng_safeFree(jumps);
+  mmng_safeFree(order);
+  mmng_safeFree(placed);
+  return out.text;
+}
+
+// Runs all optimizations of control flow on code of one function
+char *cfg_optimizeCode(const char *code, const char *labelPrefix)
+{
+  TCfg cfg = cfg_build(code, labelPrefix);
+  cfg_threadJumps(cfg);
+  cfg_computeReachability(cfg);
+  char *result = cfg_toCode(cfg);
+  cfg_destroy(cfg);
+  return result;
+}
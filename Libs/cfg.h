@@ -0,0 +1,116 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    cfg.h
+ * \brief   Control flow graph of generated code
+ *
+ * Package builds control flow graph from generated code of one function (text of instructions
+ * where entry is first instruction) and optimizes it. Code is split into basic blocks which are
+ * connected by edges of jumps and falls to next instruction. Unreachable blocks are removed,
+ * jumps are threaded over empty blocks and blocks are laid out so as many jumps as possible
+ * become falls to next block. Labels which are not used by any jump are not printed at all.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _Cfg
+#define _Cfg
+
+#include <stdbool.h>
+
+/**
+ * How control leaves basic block
+ */
+typedef enum {
+  cfgFall,  /*!< continues to fallTarget */
+  cfgJump,  /*!< unconditional jump to jumpTarget */
+  cfgCond,  /*!< conditional jump to jumpTarget, otherwise continues to fallTarget */
+  cfgEnd    /*!< block ends by RETURN, EXIT or it is end of code */
+} ECfgExit;
+
+/**
+ * One instruction (line of code without new line), text is not terminated by zero
+ */
+typedef struct {
+  const char *text; /*!< beginning of instruction */
+  unsigned len;     /*!< length of instruction */
+} TCfgInstr;
+
+/**
+ * Basic block
+ */
+typedef struct CfgBlock *TCfgBlock;
+struct CfgBlock {
+  int index;                /*!< index of block in graph (order in original code) */
+  const char *label;        /*!< name of block, NULL if block has no label */
+  unsigned labelLen;        /*!< length of label */
+  char *ownLabel;           /*!< label generated for block without one, owned by block */
+  TCfgInstr *instrs;        /*!< instructions of block without labels and final jump */
+  int instrCnt;             /*!< count of instructions */
+  int instrCap;             /*!< allocated size of instrs */
+  ECfgExit exit;            /*!< type of end of block */
+  bool isEqCond;            /*!< true for JUMPIFEQ, false for JUMPIFNEQ */
+  TCfgInstr condOperands;   /*!< operands of conditional jump */
+  int jumpTarget;           /*!< index of target block of jump, -1 if label is outside of code */
+  TCfgInstr extTarget;      /*!< label of jump outside of code */
+  int fallTarget;           /*!< index of next block */
+  int *preds;               /*!< indexes of predecessors */
+  int predCnt;              /*!< count of predecessors */
+  bool isReachable;         /*!< true if block is reachable from entry */
+};
+
+/**
+ * Control flow graph of one function
+ */
+typedef struct Cfg *TCfg;
+struct Cfg {
+  char *code;               /*!< own copy of code, instructions refer to it */
+  TCfgBlock *blocks;        /*!< all blocks, first is entry, last is empty end of code */
+  int blockCnt;             /*!< count of blocks */
+  int blockCap;             /*!< allocated size of blocks */
+  const char *labelPrefix;  /*!< prefix of generated labels */
+  unsigned labelCnt;        /*!< counter of generated labels */
+};
+
+/**
+ * Builds control flow graph from code
+ *
+ * Labels generated for blocks are "<labelPrefix>$cfg<N>", prefix has to be unique for every
+ * graph of program, so generated code of function does not depend on code of other functions.
+ * \note Memory is allocated here and cfg_destroy() has to be called.
+ */
+TCfg cfg_build(const char *code, const char *labelPrefix);
+
+/**
+ * Frees graph
+ */
+void cfg_destroy(TCfg cfg);
+
+/**
+ * Redirects jumps and falls leading to empty blocks right to their final destination
+ */
+void cfg_threadJumps(TCfg cfg);
+
+/**
+ * Marks blocks reachable from entry and computes predecessors of reachable blocks
+ */
+void cfg_computeReachability(TCfg cfg);
+
+/**
+ * Lays out reachable blocks and prints them to code
+ * \note Memory is allocated here and free has to be called.
+ */
+char *cfg_toCode(TCfg cfg);
+
+/**
+ * Runs all optimizations of control flow on code of one function
+ *
+ * \param code code of function
+ * \param labelPrefix prefix of generated labels (see cfg_build())
+ * \note Memory is allocated here and free has to be called.
+ */
+char *cfg_optimizeCode(const char *code, const char *labelPrefix);
+
+#endif // _Cfg
@@ -0,0 +1,138 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    codebuf.c
+ * \brief   Growing buffer, lines and instructions of generated code used by optimization passes
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#include <string.h>
+#include "codebuf.h"
+#include "mmng.h"
+
+#define CBUF_CHUNK 1024
+#define CBUF_LINE_CHUNK 64
+
+void cbuf_print(TCodeBuf *buffer, const char *text, unsigned len)
+{
+  while (buffer->len + len + 1 > buffer->cap)
+  {
+    buffer->cap += CBUF_CHUNK;
+    buffer->text = mmng_safeRealloc(buffer->text, sizeof(char) * buffer->cap);
+  }
+  memcpy(&buffer->text[buffer->len], text, len);
+  buffer->len += len;
+  buffer->text[buffer->len] = '\0';
+}
+
+void cbuf_printStr(TCodeBuf *buffer, const char *text)
+{
+  cbuf_print(buffer, text, strlen(text));
+}
+
+bool cbuf_nextLine(const char **code, TCodeLine *line)
+{
+  while (**code != '\0')
+  {
+    const char *lineEnd = strchr(*code, '\n');
+    if (lineEnd == NULL)
+      lineEnd = *code + strlen(*code);
+    line->text = *code;
+    line->len = lineEnd - *code;
+    *code = (*lineEnd == '\n') ? lineEnd + 1 : lineEnd;
+    if (line->len > 0)
+      return true;
+  }
+  return false;
+}
+
+int cbuf_splitLines(const char *code, TCodeLine **lines)
+{
+  int cnt = 0;
+  TCodeLine line;
+  *lines = NULL;
+  while (cbuf_nextLine(&code, &line))
+  {
+    if (cnt % CBUF_LINE_CHUNK == 0)
+      *lines = mmng_safeRealloc(*lines, sizeof(TCodeLine) * (cnt + CBUF_LINE_CHUNK));
+    (*lines)[cnt++] = line;
+  }
+  return cnt;
+}
+
+void cbuf_parseInstr(TCodeLine line, TCodeInstr *instr)
+{
+  instr->opCnt = 0;
+  const char *act = line.text;
+  const char *end = line.text + line.len;
+  while (act < end)
+  {
+    const char *tokenEnd = memchr(act, ' ', end - act);
+    if (tokenEnd == NULL || instr->opCnt == CBUF_MAX_OPERANDS - 1)
+      tokenEnd = end;
+    instr->ops[instr->opCnt] = act;
+    instr->opLens[instr->opCnt] = tokenEnd - act;
+    instr->opCnt++;
+    act = (tokenEnd < end) ? tokenEnd + 1 : end;
+  }
+}
+
+bool cbuf_isOp(TCodeInstr *instr, int index, const char *str)
+{
+  return cbuf_isOpName(instr, index, str, strlen(str));
+}
+
+bool cbuf_isOpName(TCodeInstr *instr, int index, const char *name, unsigned len)
+{
+  return index < instr->opCnt && instr->opLens[index] == len && strncmp(instr->ops[index], name, len) == 0;
+}
+
+bool cbuf_opStartsWith(TCodeInstr *instr, int index, const char *prefix)
+{
+  unsigned len = strlen(prefix);
+  return index < instr->opCnt && instr->opLens[index] >= len && strncmp(instr->ops[index], prefix, len) == 0;
+}
+
+bool cbuf_hasDest(TCodeInstr *instr)
+{
+  static const char *noDest[] = {
+    "WRITE", "PUSHS", "JUMP", "JUMPIFEQ", "JUMPIFNEQ", "LABEL", "CALL", "RETURN", "DPRINT", "BREAK",
+    "CREATEFRAME", "PUSHFRAME", "POPFRAME", NULL
+  };
+  if (instr->opCnt < 2)
+    return false;
+  for (int i = 0; noDest[i] != NULL; i++)
+    if (cbuf_isOp(instr, 0, noDest[i]))
+      return false;
+  return true;
+}
+
+int cbuf_firstRead(TCodeInstr *instr)
+{
+  return (cbuf_hasDest(instr) && !cbuf_isOp(instr, 0, "SETCHAR")) ? 2 : 1;
+}
+
+bool cbuf_isPure(TCodeInstr *instr)
+{
+  static const char *unary[] = { "MOVE", "NOT", "STRLEN", "INT2FLOAT", NULL };
+  static const char *binary[] = { "ADD", "SUB", "MUL", "CONCAT", "LT", "GT", "EQ", "AND", "OR", NULL };
+  for (int i = 0; unary[i] != NULL; i++)
+    if (cbuf_isOp(instr, 0, unary[i]))
+      return instr->opCnt == 3;
+  for (int i = 0; binary[i] != NULL; i++)
+    if (cbuf_isOp(instr, 0, binary[i]))
+      return instr->opCnt == 4;
+  return false;
+}
+
+bool cbuf_isJump(TCodeInstr *instr)
+{
+  return cbuf_isOp(instr, 0, "JUMP") || cbuf_isOp(instr, 0, "JUMPIFEQ") || cbuf_isOp(instr, 0, "JUMPIFNEQ");
+}
+
+bool cbuf_isBlockEnd(TCodeInstr *instr)
+{
+  return cbuf_isJump(instr) || cbuf_isOp(instr, 0, "RETURN");
+}
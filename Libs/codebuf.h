@@ -0,0 +1,131 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    codebuf.h
+ * \brief   Growing buffer, lines and instructions of generated code used by optimization passes
+ *
+ * Passes over generated code (inliner, control flow graph, loop-invariant code motion, copy propagation)
+ * read code as lines of instructions split to opcode and operands and print new code into growing buffer.
+ * Instructions are classified here, so all passes share one view of IFJcode17 instruction set.
+ * Unlike TMemBuf of compiler drivers, memory is allocated by memory manager and belongs to compilation.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _CodeBuf
+#define _CodeBuf
+
+#include <stdbool.h>
+
+#define CBUF_MAX_OPERANDS 4
+
+/**
+ * Growing buffer of code, text is always terminated by zero
+ */
+typedef struct {
+  char *text;     /*!< content of buffer, NULL if nothing was printed yet */
+  unsigned len;   /*!< length of content */
+  unsigned cap;   /*!< allocated size of text */
+} TCodeBuf;
+
+/**
+ * One line of code (without new line), text is not terminated by zero
+ */
+typedef struct {
+  const char *text;
+  unsigned len;
+} TCodeLine;
+
+/**
+ * Instruction split to opcode and operands, texts are not terminated by zero
+ */
+typedef struct {
+  const char *ops[CBUF_MAX_OPERANDS];  /*!< opcode and operands */
+  unsigned opLens[CBUF_MAX_OPERANDS];  /*!< lengths of opcode and operands */
+  int opCnt;                           /*!< count of opcode and operands */
+} TCodeInstr;
+
+/**
+ * Appends text to buffer
+ *
+ * \param buffer buffer
+ * \param text text
+ * \param len length of text
+ */
+void cbuf_print(TCodeBuf *buffer, const char *text, unsigned len);
+
+/**
+ * Appends zero terminated string to buffer
+ */
+void cbuf_printStr(TCodeBuf *buffer, const char *text);
+
+/**
+ * Reads next non-empty line of code
+ *
+ * \param code position in code, it is moved after the line
+ * \param line output of line
+ * \returns false if there is no more line in code
+ */
+bool cbuf_nextLine(const char **code, TCodeLine *line);
+
+/**
+ * Splits code into non-empty lines
+ *
+ * \param code code
+ * \param lines output of array of lines, NULL if code is empty
+ * \returns count of lines
+ * \note Memory of lines is allocated here and free has to be called.
+ */
+int cbuf_splitLines(const char *code, TCodeLine **lines);
+
+/**
+ * Splits instruction to opcode and operands separated by space, the last operand holds the rest of line
+ *
+ * \param line line of instruction
+ * \param instr output of instruction
+ */
+void cbuf_parseInstr(TCodeLine line, TCodeInstr *instr);
+
+/**
+ * Checks if operand (or opcode) index of instruction is str
+ */
+bool cbuf_isOp(TCodeInstr *instr, int index, const char *str);
+
+/**
+ * Checks if operand index of instruction is name which is not terminated by zero
+ */
+bool cbuf_isOpName(TCodeInstr *instr, int index, const char *name, unsigned len);
+
+/**
+ * Checks if operand index of instruction begins with prefix
+ */
+bool cbuf_opStartsWith(TCodeInstr *instr, int index, const char *prefix);
+
+/**
+ * Checks if first operand of instruction is variable assigned by it
+ */
+bool cbuf_hasDest(TCodeInstr *instr);
+
+/**
+ * Returns index of first operand which is read by instruction
+ */
+int cbuf_firstRead(TCodeInstr *instr);
+
+/**
+ * Checks if instruction cannot fail and its only effect is assignment of its result
+ */
+bool cbuf_isPure(TCodeInstr *instr);
+
+/**
+ * Checks if instruction is conditional or unconditional jump
+ */
+bool cbuf_isJump(TCodeInstr *instr);
+
+/**
+ * Checks if instruction ends basic block (jump or return from function)
+ */
+bool cbuf_isBlockEnd(TCodeInstr *instr);
+
+#endif // _CodeBuf
@@ -0,0 +1,144 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    compilerctx.h
+ * \brief   Compiler context, state of one compilation
+ *
+ * All state of compiler modules which used to live in process-wide globals is part of compiler
+ * context. Every thread works with its own actual context (GLBCompilerCtx), which is set for the
+ * time of compilation by ifjc_compile. Modules reach their state only through the actual context,
+ * so more programs can be compiled in one process, even concurrently in more threads.
+ *
+ * States of modules are referenced by pointers to their internal structures, which are defined
+ * only in sources of modules.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _CompilerCtx
+#define _CompilerCtx
+
+#include <stdbool.h>
+#include <setjmp.h>
+#include "ifjc.h"
+#include "stacks.h"
+#include "symtable.h"
+#include "stats.h"
+
+/**
+ * State of one compilation
+ */
+struct CompilerCtx {
+  // input and output
+  const char *src;              /*!< source code, NULL if it is read from standard input */
+  unsigned srcLen;              /*!< length of source code */
+  unsigned srcPos;              /*!< position of next character of source code */
+  TIfjcOutput output;           /*!< output of generated code, NULL for standard output */
+  void *outputData;             /*!< user data passed to output */
+  TIfjcOutput diagnostics;      /*!< output of error messages, NULL for standard error output */
+  void *diagnosticsData;        /*!< user data passed to diagnostics */
+  const char *incrementalPath;  /*!< file of incremental compilation, NULL if it is disabled */
+  unsigned jobCnt;              /*!< count of threads generating code of functions */
+  unsigned maxBuffer;           /*!< size of buffered code of main function which is streamed to output, 0 for no limit */
+  bool isExitTeardown;          /*!< memory is left to be released by exit of process */
+  struct Parallel *parallel;    /*!< parallel code generation of main compilation, NULL if it is not used */
+  jmp_buf *errJump;             /*!< return point of compilation on error, NULL if error ends process */
+  int errCode;                  /*!< error code of compilation, 0 on success */
+
+  // memory manager
+  struct PList *pointerList;    /*!< list of all allocated pointers */
+  #ifdef MMNG_PROFILE
+  struct MMProfile *mmProfile;  /*!< profile of allocations */
+  #endif // MMNG_PROFILE
+
+  // tables
+  TPStack symbTabStack;         /*!< stack of symbol tables */
+  struct ConstPool *constPool;  /*!< pool of constants */
+
+  // analyzers
+  struct LAnalyzer *scanner;    /*!< lexical analyzer */
+  TTkList tlist;                /*!< list used as stack in precedence analysis */
+  struct TmpAllocator *tmpAllocator; /*!< allocator of auxiliary variables */
+  struct CondContext *condContext; /*!< context of actually processed condition */
+  TSymbol convertedSymbol;      /*!< symbol of last implicit conversion */
+  unsigned frameCnt;            /*!< counter of frames of recursive parser */
+  struct Incremental *incremental; /*!< state of incremental compilation, NULL if it is disabled */
+
+  // code generation
+  char *Iarr;                   /*!< code buffer of actual function */
+  unsigned arrPos;              /*!< length of code in buffer */
+  unsigned arrSize;             /*!< allocated size of buffer */
+  bool lastWasCreateFrame;      /*!< last printed instruction was CREATEFRAME, code printer of utils skips repeated one */
+  unsigned deadCodeLevel;       /*!< when non-zero, printed code is unreachable and it is thrown away */
+  struct CodeUnit **codeUnits;  /*!< units of output code */
+  unsigned unitCnt;
+  unsigned unitCap;
+  unsigned inlSiteCnt;          /*!< counter of inlined call sites */
+  unsigned licmVarCnt;          /*!< counter of variables created by loop invariant code motion */
+  unsigned streamedCnt;         /*!< count of blocks of main function already printed to output */
+  unsigned streamedTemps;       /*!< count of temporary variables defined by printed blocks */
+  unsigned streamedVars;        /*!< count of auxiliary variables of copy propagation defined by printed blocks */
+
+  #ifdef STATS
+  TStats stats;                 /*!< counters of compilation */
+  #endif // STATS
+};
+
+/**
+ * Actual compiler context of thread
+ */
+extern __thread TCompilerCtx GLBCompilerCtx;
+
+/**
+ * Reads next character of source code
+ *
+ * \returns character or EOF on the end of source code
+ */
+int ctx_getChar();
+
+/**
+ * Writes generated code to output of actual compilation
+ *
+ * \param data code
+ * \param len length of code
+ */
+void ctx_output(const char *data, unsigned len);
+
+/**
+ * Prints error message to diagnostics of actual compilation
+ *
+ * \param format format of message as in printf
+ */
+void ctx_printError(const char *format, ...);
+
+/**
+ * Runs compilation in context, modules of compiler are initialized before process is called and
+ * destroyed after it, errors end process and they are returned
+ *
+ * Settings of context (diagnostics, incremental compilation, jobs, buffer limit, teardown) are kept, rest of context is cleared.
+ *
+ * \param ctx compiler context
+ * \param src source code, NULL to read it from standard input
+ * \param len length of source code
+ * \param output output of generated code, NULL to write it to standard output
+ * \param userData user data passed to output
+ * \param process processing of source code (whole program or one function)
+ * \param arg argument of process
+ * \returns 0 on success, otherwise error code of compilation (ErrType)
+ */
+int ctx_run(TCompilerCtx ctx, const char *src, unsigned len, TIfjcOutput output, void *userData,
+  void (*process)(void *arg), void *arg);
+
+/**
+ * Ends actual compilation with error code
+ *
+ * Compilation started by ifjc_compile returns the error code, otherwise process exits with it.
+ * All memory of compilation has to be already freed.
+ *
+ * \param code error code (ErrType)
+ */
+void ctx_raiseError(int code);
+
+#endif // _CompilerCtx
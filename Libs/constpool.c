@@ -0,0 +1,335 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    constpool.c
+ * \brief   Pool of constants
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "constpool.h"
+#include "mmng.h"
+#include "apperr.h"
+#include "compilerctx.h"
+
+#define CPOOL_CHUNK 64
+
+// =============================================================================
+// ================= Iternal data structures definition ========================
+// =============================================================================
+
+/**
+ * Hash table of constants
+ *
+ * Constants are stored in array in order of insertion (index of constant is index to this array)
+ * and they are chained by indexes into buckets of hash table.
+ */
+typedef struct ConstPool *TConstPool;
+struct ConstPool {
+  TSymbol *items;     /*!< array of constant symbols */
+  unsigned *hashes;   /*!< array of hashes of constants */
+  int *next;          /*!< array of indexes of next constant in the same bucket, -1 on the end */
+  int count;          /*!< count of constants in pool */
+  int capacity;       /*!< allocated length of items, hashes and next arrays */
+  int *buckets;       /*!< indexes of first constants in buckets, -1 for empty bucket */
+  int bucketCnt;      /*!< count of buckets, always power of two */
+};
+
+// internal instance of pool of constants is part of actual compiler context
+#define GLBConstPool (GLBCompilerCtx->constPool)
+
+// =============================================================================
+// ====================== support functions ====================================
+// =============================================================================
+
+// error if pool is not initialized
+void cpool_assertIfNotInit()
+{
+  if (GLBConstPool == NULL)
+    apperr_runtimeError("Pool of constants is not initialized.");
+}
+
+// FNV-1a hash of memory block continuing from hash value
+unsigned cpool_hashBytes(unsigned hash, const void *bytes, size_t len)
+{
+  const unsigned char *actByte = bytes;
+  for (size_t i = 0; i < len; i++)
+  {
+    hash ^= actByte[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// hash of constant value
+unsigned cpool_hash(DataType dataType, Data data)
+{
+  unsigned hash = 2166136261u;
+  unsigned char dtByte = (unsigned char)dataType;
+  hash = cpool_hashBytes(hash, &dtByte, 1);
+  switch (dataType)
+  {
+    case dtInt: return cpool_hashBytes(hash, &data.intVal, sizeof(int));
+    case dtFloat: return cpool_hashBytes(hash, &data.doubleVal, sizeof(double));
+    case dtString: return cpool_hashBytes(hash, data.stringVal, strlen(data.stringVal));
+    case dtBool: return cpool_hashBytes(hash, &data.boolVal, sizeof(bool));
+    default:
+      apperr_runtimeError("Pool of constants: constant with unspecified data type.");
+  }
+  return hash;
+}
+
+// compares value of constant symbol with data
+bool cpool_equals(TSymbol symbol, DataType dataType, Data data)
+{
+  if (symbol->dataType != dataType)
+    return false;
+  switch (dataType)
+  {
+    // doubles are compared by bit patterns so 0.0 and -0.0 stays two constants
+    case dtInt: return symbol->data.intVal == data.intVal;
+    case dtFloat: return memcmp(&symbol->data.doubleVal, &data.doubleVal, sizeof(double)) == 0;
+    case dtString: return strcmp(symbol->data.stringVal, data.stringVal) == 0;
+    case dtBool: return symbol->data.boolVal == data.boolVal;
+    default: return false;
+  }
+}
+
+/**
+ * Creates canonical form of string literal in format of output code
+ *
+ * All escape sequences \ddd are decoded and characters are escaped again
+ * only if it is required (white space, control characters, '#' and '\'),
+ * so the same strings written differently in source code are one constant.
+ * \note Memory is allocated here and free has to be called.
+ */
+char *cpool_canonicalString(const char *str)
+{
+  size_t len = strlen(str);
+  char *res = mmng_safeMalloc(sizeof(char) * (len * 4 + 1)); // every char can be escaped in worst case
+  size_t resPos = 0;
+  for (size_t i = 0; i < len; i++)
+  {
+    unsigned char actChar = str[i];
+    if (actChar == '\\' && i + 3 < len &&
+        str[i + 1] >= '0' && str[i + 1] <= '9' &&
+        str[i + 2] >= '0' && str[i + 2] <= '9' &&
+        str[i + 3] >= '0' && str[i + 3] <= '9')
+    {
+      actChar = (str[i + 1] - '0') * 100 + (str[i + 2] - '0') * 10 + (str[i + 3] - '0');
+      i += 3;
+    }
+    if (actChar <= 32 || actChar == '#' || actChar == '\\')
+      resPos += sprintf(&res[resPos], "\\%03u", actChar);
+    else
+      res[resPos++] = actChar;
+  }
+  res[resPos] = '\0';
+  return res;
+}
+
+// creates identifier of constant in form of operand of output code
+char *cpool_createIdent(TSymbol symbol)
+{
+  char *ident = NULL;
+  switch (symbol->dataType)
+  {
+    case dtInt:
+      ident = mmng_safeMalloc(sizeof(char) * 16);
+      sprintf(ident, "int@%d", symbol->data.intVal);
+      break;
+    case dtFloat:
+      ident = mmng_safeMalloc(sizeof(char) * 32);
+      sprintf(ident, "float@%g", symbol->data.doubleVal);
+      break;
+    case dtString:
+      ident = util_StrConcatenate("string@", symbol->data.stringVal);
+      break;
+    case dtBool:
+      ident = util_StrHardCopy(symbol->data.boolVal ? "bool@true" : "bool@false");
+      break;
+    default:
+      apperr_runtimeError("Pool of constants: constant with unspecified data type.");
+  }
+  return ident;
+}
+
+// doubles count of buckets and rehash all constants
+void cpool_rehash()
+{
+  mmng_safeFree(GLBConstPool->buckets);
+  GLBConstPool->bucketCnt *= 2;
+  GLBConstPool->buckets = mmng_safeMalloc(sizeof(int) * GLBConstPool->bucketCnt);
+  for (int i = 0; i < GLBConstPool->bucketCnt; i++)
+    GLBConstPool->buckets[i] = -1;
+  for (int i = 0; i < GLBConstPool->count; i++)
+  {
+    int bucket = GLBConstPool->hashes[i] & (GLBConstPool->bucketCnt - 1);
+    GLBConstPool->next[i] = GLBConstPool->buckets[bucket];
+    GLBConstPool->buckets[bucket] = i;
+  }
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+// Initialization of global pool of constants
+void cpool_init()
+{
+  if (GLBConstPool != NULL)
+    apperr_runtimeError("Pool of constants is already initialized.");
+
+  GLBConstPool = mmng_safeMalloc(sizeof(struct ConstPool));
+  GLBConstPool->count = 0;
+  GLBConstPool->capacity = CPOOL_CHUNK;
+  GLBConstPool->items = mmng_safeMalloc(sizeof(TSymbol) * CPOOL_CHUNK);
+  GLBConstPool->hashes = mmng_safeMalloc(sizeof(unsigned) * CPOOL_CHUNK);
+  GLBConstPool->next = mmng_safeMalloc(sizeof(int) * CPOOL_CHUNK);
+  GLBConstPool->bucketCnt = CPOOL_CHUNK;
+  GLBConstPool->buckets = mmng_safeMalloc(sizeof(int) * CPOOL_CHUNK);
+  for (int i = 0; i < GLBConstPool->bucketCnt; i++)
+    GLBConstPool->buckets[i] = -1;
+}
+
+// Frees pool and all its constants
+void cpool_destroy()
+{
+  if (GLBConstPool == NULL)
+    return;
+
+  for (int i = 0; i < GLBConstPool->count; i++)
+  {
+    TSymbol symbol = GLBConstPool->items[i];
+    if (symbol->dataType == dtString)
+      mmng_safeFree(symbol->data.stringVal);
+    mmng_safeFree(symbol->ident);
+    mmng_safeFree(symbol);
+  }
+  mmng_safeFree(GLBConstPool->items);
+  mmng_safeFree(GLBConstPool->hashes);
+  mmng_safeFree(GLBConstPool->next);
+  mmng_safeFree(GLBConstPool->buckets);
+  mmng_safeFree(GLBConstPool);
+  GLBConstPool = NULL;
+}
+
+// Finds constant with given data type and value or inserts new one
+int cpool_insert(DataType dataType, Data data)
+{
+  cpool_assertIfNotInit();
+
+  char *canonStr = NULL;
+  if (dataType == dtString)
+  {
+    if (data.stringVal == NULL)
+      apperr_runtimeError("Pool of constants: NULL string constant.");
+    canonStr = cpool_canonicalString(data.stringVal);
+    data.stringVal = canonStr;
+  }
+
+  // search in bucket
+  unsigned hash = cpool_hash(dataType, data);
+  int bucket = hash & (GLBConstPool->bucketCnt - 1);
+  for (int i = GLBConstPool->buckets[bucket]; i >= 0; i = GLBConstPool->next[i])
+  {
+    if (GLBConstPool->hashes[i] == hash && cpool_equals(GLBConstPool->items[i], dataType, data))
+    {
+      if (canonStr != NULL)
+        mmng_safeFree(canonStr);
+      return i;
+    }
+  }
+
+  // create new constant
+  if (GLBConstPool->count == GLBConstPool->capacity)
+  {
+    GLBConstPool->capacity += CPOOL_CHUNK;
+    GLBConstPool->items = mmng_safeRealloc(GLBConstPool->items, sizeof(TSymbol) * GLBConstPool->capacity);
+    GLBConstPool->hashes = mmng_safeRealloc(GLBConstPool->hashes, sizeof(unsigned) * GLBConstPool->capacity);
+    GLBConstPool->next = mmng_safeRealloc(GLBConstPool->next, sizeof(int) * GLBConstPool->capacity);
+  }
+
+  TSymbol symbol = mmng_safeMalloc(sizeof(struct Symbol));
+  symbol->type = symtConstant;
+  symbol->dataType = dataType;
+  symbol->data = data; // string is already owned copy
+  symbol->isTemp = false;
+  symbol->ident = cpool_createIdent(symbol);
+  symbol->key = strchr(symbol->ident, '@') + 1;
+
+  int index = GLBConstPool->count++;
+  GLBConstPool->items[index] = symbol;
+  GLBConstPool->hashes[index] = hash;
+  GLBConstPool->next[index] = GLBConstPool->buckets[bucket];
+  GLBConstPool->buckets[bucket] = index;
+
+  // keep load factor under 1
+  if (GLBConstPool->count > GLBConstPool->bucketCnt)
+    cpool_rehash();
+
+  return index;
+}
+
+// Gets constant symbol by its index
+TSymbol cpool_get(int index)
+{
+  cpool_assertIfNotInit();
+  if (index < 0 || index >= GLBConstPool->count)
+    apperr_runtimeError("Pool of constants: index out of range.");
+  return GLBConstPool->items[index];
+}
+
+// Gets index of constant symbol in pool, -1 if symbol is not from pool
+int cpool_indexOf(TSymbol symbol)
+{
+  cpool_assertIfNotInit();
+  if (symbol == NULL || symbol->type != symtConstant)
+    return -1;
+
+  unsigned hash = cpool_hash(symbol->dataType, symbol->data);
+  int bucket = hash & (GLBConstPool->bucketCnt - 1);
+  for (int i = GLBConstPool->buckets[bucket]; i >= 0; i = GLBConstPool->next[i])
+    if (GLBConstPool->items[i] == symbol)
+      return i;
+  return -1;
+}
+
+// Count of distinct constants in pool
+int cpool_count()
+{
+  cpool_assertIfNotInit();
+  return GLBConstPool->count;
+}
+
+TSymbol cpool_int(int val)
+{
+  Data data;
+  data.intVal = val;
+  return cpool_get(cpool_insert(dtInt, data));
+}
+
+TSymbol cpool_double(double val)
+{
+  Data data;
+  data.doubleVal = val;
+  return cpool_get(cpool_insert(dtFloat, data));
+}
+
+TSymbol cpool_string(const char *val)
+{
+  Data data;
+  data.stringVal = (char *)val;
+  return cpool_get(cpool_insert(dtString, data));
+}
+
+TSymbol cpool_bool(bool val)
+{
+  Data data;
+  data.boolVal = val;
+  return cpool_get(cpool_insert(dtBool, data));
+}
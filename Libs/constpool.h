@@ -0,0 +1,73 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    constpool.h
+ * \brief   Pool of constants
+ *
+ * Package evides every distinct constant (literal) of compiled program exactly once.
+ * Constants are keyed by pair (data type, value) and stored in hash table,
+ * so for example "1" and "01" or two same string literals are one constant.
+ * Every constant has its index in pool and is represented by read-only symbol of type symtConstant,
+ * which is used by tokens in the same way as symbols from symbol table.
+ * Constants are not stored in symbol table at all.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _ConstPool
+#define _ConstPool
+
+#include <stdbool.h>
+#include "symtable.h"
+
+/**
+ * Initialization of global pool of constants
+ *
+ * If function is called and pool is already initialized error is thrown.
+ */
+void cpool_init();
+
+/**
+ * Frees pool and all its constants
+ */
+void cpool_destroy();
+
+/**
+ * Finds constant with given data type and value or inserts new one
+ *
+ * \param DataType dataType data type of constant, decides which attribute from data is used
+ * \param Data data value of constant (string value is copied)
+ * \returns int index of constant in pool
+ */
+int cpool_insert(DataType dataType, Data data);
+
+/**
+ * Gets constant symbol by its index
+ *
+ * \param int index index of constant returned by cpool_insert()
+ * \returns TSymbol read-only symbol of constant
+ * \note Symbol must not be changed, it is shared by all occurrences of constant.
+ */
+TSymbol cpool_get(int index);
+
+/**
+ * Gets index of constant symbol in pool, -1 if symbol is not from pool
+ */
+int cpool_indexOf(TSymbol symbol);
+
+/**
+ * Count of distinct constants in pool
+ */
+int cpool_count();
+
+/**
+ * Shortcuts finding or inserting constant of concrete data type and returning its symbol
+ */
+TSymbol cpool_int(int val);
+TSymbol cpool_double(double val);
+TSymbol cpool_string(const char *val);
+TSymbol cpool_bool(bool val);
+
+#endif // _ConstPool
@@ -0,0 +1,1197 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    copyprop.c
+ * \brief   Copy propagation and dead-store elimination
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include "copyprop.h"
+#include "codebuf.h"
+#include "mmng.h"
+
+#define CPROP_CHUNK 64
+#define CPROP_MAX_ROUNDS 4 // maximal count of repetitions of all optimizations
+#define CPROP_END -1       // successor of block which leaves function by RETURN or end of code
+#define CPROP_OUTSIDE -2   // successor of block which jumps to label outside of code
+#define CPROP_MAX_VALUES 64 // maximal count of available values in one basic block
+#define CPROP_MAX_NEW_VARS 32 // maximal count of auxiliary variables created by value numbering in function
+#define CPROP_MAX_CONVS 32    // maximal count of distinct cached conversions of variables in function
+
+/**
+ * Instruction with variables of its operands
+ */
+typedef struct {
+  TCodeInstr code;               /*!< opcode and operands */
+  int vars[CBUF_MAX_OPERANDS];   /*!< index of variable in operand, -1 if operand is not variable */
+  bool isCall;                   /*!< instruction is part of call sequence */
+  bool isRemoved;                /*!< instruction was deleted */
+} TCpropInstr;
+
+/**
+ * Basic block, range of instructions
+ */
+typedef struct {
+  int first;          /*!< index of first instruction */
+  int end;            /*!< index after last instruction */
+  int succs[2];       /*!< indexes of successors or CPROP_END, CPROP_OUTSIDE */
+  int succCnt;        /*!< count of successors */
+  unsigned *liveIn;   /*!< variables live on start of block */
+  unsigned *liveOut;  /*!< variables live on end of block */
+} TCpropBlock;
+
+/**
+ * Value computed in basic block, operation with value numbers of its source operands
+ */
+typedef struct {
+  const char *ops[CBUF_MAX_OPERANDS];  /*!< opcode and operands, source operands are from index 2 */
+  unsigned opLens[CBUF_MAX_OPERANDS];  /*!< lengths of opcode and operands */
+  int vns[CBUF_MAX_OPERANDS];          /*!< value numbers of variable operands, 0 for constants */
+  int opCnt;                           /*!< count of opcode and operands */
+  int vn;                              /*!< value number of result */
+  int holder;                          /*!< variable which got result */
+  int lastProt;                        /*!< last instruction renamed to keep value in holder, -1 if none */
+} TCpropValue;
+
+/**
+ * Hash table of names (variables and labels), value is index of name
+ */
+typedef struct {
+  const char **names;
+  unsigned *lens;
+  int *values;
+  unsigned size;
+  int cnt;
+} TCpropHash;
+
+/**
+ * Code of function being optimized
+ */
+typedef struct {
+  TCpropInstr *instrs;
+  int instrCnt;
+  TCpropHash vars;      /*!< variables of function */
+  int varCnt;
+  int varCap;           /*!< maximal count of variables including new auxiliary variables */
+  int retval;           /*!< index of return value LF@%retval, the only variable read after function ends */
+  unsigned *tempVars;   /*!< set of variables of temporary frame */
+  const char **varOps;  /*!< names of variables */
+  unsigned *varLens;    /*!< lengths of names of variables */
+  char **newVars;       /*!< names of auxiliary variables created by value numbering (TF@%V<n>) */
+  int newVarCnt;
+  char **texts;         /*!< constant operands created by optimizations */
+  int textCnt;
+  TCpropBlock *blocks;
+  int blockCnt;
+  unsigned words;       /*!< size of set of variables in words */
+  bool isOpenEnd;       /*!< code continues after its end, all variables are live there */
+} TCpropFunc;
+
+// =============================================================================
+// ====================== support functions ====================================
+// =============================================================================
+
+// hash of name
+unsigned cprop_hashName(const char *name, unsigned len)
+{
+  unsigned hash = 2166136261u;
+  for (unsigned i = 0; i < len; i++)
+    hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+  return hash;
+}
+
+// initializes hash table for at least cnt names
+void cprop_hashInit(TCpropHash *table, int cnt)
+{
+  table->size = 16;
+  while (table->size < (unsigned)cnt * 2)
+    table->size *= 2;
+  table->names = mmng_safeMalloc(sizeof(char *) * table->size);
+  table->lens = mmng_safeMalloc(sizeof(unsigned) * table->size);
+  table->values = mmng_safeMalloc(sizeof(int) * table->size);
+  for (unsigned i = 0; i < table->size; i++)
+    table->names[i] = NULL;
+  table->cnt = 0;
+}
+
+// frees hash table
+void cprop_hashFree(TCpropHash *table)
+{
+  mmng_safeFree(table->names);
+  mmng_safeFree(table->lens);
+  mmng_safeFree(table->values);
+}
+
+// finds name in hash table, it is inserted with value if it is not there and value is not negative
+int cprop_hashFind(TCpropHash *table, const char *name, unsigned len, int value)
+{
+  unsigned i = cprop_hashName(name, len) & (table->size - 1);
+  while (table->names[i] != NULL)
+  {
+    if (table->lens[i] == len && strncmp(table->names[i], name, len) == 0)
+      return table->values[i];
+    i = (i + 1) & (table->size - 1);
+  }
+  if (value < 0)
+    return -1;
+  table->names[i] = name;
+  table->lens[i] = len;
+  table->values[i] = value;
+  table->cnt++;
+  return value;
+}
+
+// true if result of instruction depends only on its operands
+bool cprop_isValueOp(TCpropInstr *instr)
+{
+  static const char *unary[] = {
+    "NOT", "STRLEN", "INT2FLOAT", "FLOAT2INT", "FLOAT2R2EINT", "FLOAT2R2OINT", "INT2CHAR", "TYPE", NULL
+  };
+  static const char *binary[] = {
+    "ADD", "SUB", "MUL", "DIV", "CONCAT", "LT", "GT", "EQ", "AND", "OR", "STRI2INT", "GETCHAR", NULL
+  };
+  for (int i = 0; unary[i] != NULL; i++)
+    if (cbuf_isOp(&instr->code, 0, unary[i]))
+      return instr->code.opCnt == 3;
+  for (int i = 0; binary[i] != NULL; i++)
+    if (cbuf_isOp(&instr->code, 0, binary[i]))
+      return instr->code.opCnt == 4;
+  return false;
+}
+
+// true if operands of binary operation can be swapped
+bool cprop_isCommutative(TCpropInstr *instr)
+{
+  return cbuf_isOp(&instr->code, 0, "ADD") || cbuf_isOp(&instr->code, 0, "MUL") || cbuf_isOp(&instr->code, 0, "EQ") ||
+    cbuf_isOp(&instr->code, 0, "AND") || cbuf_isOp(&instr->code, 0, "OR");
+}
+
+// true if texts are equal
+bool cprop_isSameText(const char *text1, unsigned len1, const char *text2, unsigned len2)
+{
+  return len1 == len2 && strncmp(text1, text2, len1) == 0;
+}
+
+// true if instruction computes value, vns are value numbers of its operands
+bool cprop_computesValue(TCpropInstr *instr, int *vns, TCpropValue *value)
+{
+  if (instr->code.opCnt != value->opCnt ||
+      !cprop_isSameText(instr->code.ops[0], instr->code.opLens[0], value->ops[0], value->opLens[0]))
+    return false;
+  int order[2][2] = { { 2, 3 }, { 3, 2 } };
+  for (int k = 0; k < (cprop_isCommutative(instr) ? 2 : 1); k++)
+  {
+    bool isSame = true;
+    for (int i = 2; i < instr->code.opCnt && isSame; i++)
+    {
+      int j = (instr->code.opCnt == 4) ? order[k][i - 2] : i;
+      isSame = (vns[i] != 0) ? vns[i] == value->vns[j] :
+        value->vns[j] == 0 &&
+        cprop_isSameText(instr->code.ops[i], instr->code.opLens[i], value->ops[j], value->opLens[j]);
+    }
+    if (isSame)
+      return true;
+  }
+  return false;
+}
+
+// true if instruction changes frames outside of call sequence, names of variables change their meaning there
+bool cprop_isBarrier(TCpropInstr *instr)
+{
+  return !instr->isCall && (cbuf_isOp(&instr->code, 0, "CREATEFRAME") || cbuf_isOp(&instr->code, 0, "PUSHFRAME") ||
+    cbuf_isOp(&instr->code, 0, "POPFRAME"));
+}
+
+// true if instruction writes variable assigned by it and does not read it
+bool cprop_isDef(TCpropInstr *instr)
+{
+  return cbuf_hasDest(&instr->code) && instr->vars[1] >= 0 && !cbuf_isOp(&instr->code, 0, "SETCHAR");
+}
+
+// true if instruction reads or writes variable
+bool cprop_refersTo(TCpropInstr *instr, int var)
+{
+  for (int i = 1; i < instr->code.opCnt; i++)
+    if (instr->vars[i] == var)
+      return true;
+  return false;
+}
+
+// splits code into instructions, returns their count
+int cprop_parse(const char *code, TCpropInstr **instrs)
+{
+  int cnt = 0;
+  TCodeLine line;
+  *instrs = NULL;
+  while (cbuf_nextLine(&code, &line))
+  {
+    if (cnt % CPROP_CHUNK == 0)
+      *instrs = mmng_safeRealloc(*instrs, sizeof(TCpropInstr) * (cnt + CPROP_CHUNK));
+    TCpropInstr *instr = &(*instrs)[cnt++];
+    cbuf_parseInstr(line, &instr->code);
+    for (int j = 0; j < instr->code.opCnt; j++)
+      instr->vars[j] = -1;
+    instr->isCall = false;
+    instr->isRemoved = false;
+  }
+  return cnt;
+}
+
+// marks call sequences: PUSHFRAME, CREATEFRAME, (DEFVAR TF@p, POPS TF@p)*, CALL f, PUSHS TF@%retval, POPFRAME
+void cprop_markCalls(TCpropFunc *func)
+{
+  TCpropInstr *instrs = func->instrs;
+  for (int i = 0; i + 1 < func->instrCnt; i++)
+  {
+    if (!cbuf_isOp(&instrs[i].code, 0, "PUSHFRAME") || !cbuf_isOp(&instrs[i + 1].code, 0, "CREATEFRAME"))
+      continue;
+    int j = i + 2;
+    while (j + 1 < func->instrCnt && cbuf_isOp(&instrs[j].code, 0, "DEFVAR") &&
+           cbuf_isOp(&instrs[j + 1].code, 0, "POPS") &&
+           cbuf_opStartsWith(&instrs[j].code, 1, "TF@") && instrs[j].code.opLens[1] == instrs[j + 1].code.opLens[1] &&
+           strncmp(instrs[j].code.ops[1], instrs[j + 1].code.ops[1], instrs[j].code.opLens[1]) == 0)
+      j += 2;
+    if (j + 2 < func->instrCnt && cbuf_isOp(&instrs[j].code, 0, "CALL") && cbuf_isOp(&instrs[j + 1].code, 0, "PUSHS") &&
+        cbuf_isOp(&instrs[j + 1].code, 1, "TF@%retval") && cbuf_isOp(&instrs[j + 2].code, 0, "POPFRAME"))
+    {
+      for (int k = i; k <= j + 2; k++)
+        instrs[k].isCall = true;
+      i = j + 2;
+    }
+  }
+}
+
+// assigns indexes to variables in operands of instructions outside of call sequences
+void cprop_indexVars(TCpropFunc *func)
+{
+  cprop_hashInit(&func->vars, func->instrCnt * 2);
+  func->varCnt = 0;
+  for (int i = 0; i < func->instrCnt; i++)
+  {
+    TCpropInstr *instr = &func->instrs[i];
+    if (instr->isCall)
+      continue;
+    for (int j = 1; j < instr->code.opCnt; j++)
+      if (cbuf_opStartsWith(&instr->code, j, "LF@") || cbuf_opStartsWith(&instr->code, j, "TF@") ||
+          cbuf_opStartsWith(&instr->code, j, "GF@"))
+      {
+        instr->vars[j] = cprop_hashFind(&func->vars, instr->code.ops[j], instr->code.opLens[j], func->varCnt);
+        if (instr->vars[j] == func->varCnt)
+          func->varCnt++;
+      }
+  }
+  // value numbering and caching of conversions can create new variables
+  func->varCap = func->varCnt + CPROP_MAX_NEW_VARS;
+  func->words = (func->varCap + 31) / 32;
+  func->varOps = mmng_safeMalloc(sizeof(char *) * func->varCap);
+  func->varLens = mmng_safeMalloc(sizeof(unsigned) * func->varCap);
+  for (int i = 0; i < func->instrCnt; i++)
+    for (int j = 1; j < func->instrs[i].code.opCnt; j++)
+      if (func->instrs[i].vars[j] >= 0)
+      {
+        func->varOps[func->instrs[i].vars[j]] = func->instrs[i].code.ops[j];
+        func->varLens[func->instrs[i].vars[j]] = func->instrs[i].code.opLens[j];
+      }
+  func->newVars = NULL;
+  func->newVarCnt = 0;
+  func->texts = NULL;
+  func->textCnt = 0;
+  func->retval = cprop_hashFind(&func->vars, "LF@%retval", 10, -1);
+  func->tempVars = mmng_safeMalloc(sizeof(unsigned) * (func->words + 1));
+  memset(func->tempVars, 0, sizeof(unsigned) * (func->words + 1));
+  for (int i = 0; i < func->instrCnt; i++)
+    for (int j = 1; j < func->instrs[i].code.opCnt; j++)
+      if (func->instrs[i].vars[j] >= 0 && cbuf_opStartsWith(&func->instrs[i].code, j, "TF@"))
+        func->tempVars[func->instrs[i].vars[j] / 32] |= 1u << (func->instrs[i].vars[j] % 32);
+}
+
+// set of variables live after end of function
+void cprop_setEndLive(TCpropFunc *func, unsigned *live)
+{
+  memset(live, 0, sizeof(unsigned) * func->words);
+  if (func->retval >= 0)
+    live[func->retval / 32] |= 1u << (func->retval % 32);
+}
+
+// splits instructions into basic blocks and connects them by edges
+void cprop_buildBlocks(TCpropFunc *func)
+{
+  func->blocks = NULL;
+  func->blockCnt = 0;
+  int start = 0;
+  for (int i = 1; i <= func->instrCnt; i++)
+  {
+    if (i < func->instrCnt && !cbuf_isOp(&func->instrs[i].code, 0, "LABEL") &&
+        !cbuf_isBlockEnd(&func->instrs[i - 1].code))
+      continue;
+    if (func->blockCnt % CPROP_CHUNK == 0)
+      func->blocks = mmng_safeRealloc(func->blocks, sizeof(TCpropBlock) * (func->blockCnt + CPROP_CHUNK));
+    TCpropBlock *block = &func->blocks[func->blockCnt++];
+    block->first = start;
+    block->end = i;
+    block->succCnt = 0;
+    block->liveIn = mmng_safeMalloc(sizeof(unsigned) * (func->words + 1));
+    block->liveOut = mmng_safeMalloc(sizeof(unsigned) * (func->words + 1));
+    memset(block->liveIn, 0, sizeof(unsigned) * (func->words + 1));
+    start = i;
+  }
+
+  // labels of blocks
+  TCpropHash labels;
+  cprop_hashInit(&labels, func->blockCnt);
+  for (int b = 0; b < func->blockCnt; b++)
+  {
+    TCpropInstr *first = &func->instrs[func->blocks[b].first];
+    if (func->blocks[b].end > func->blocks[b].first && cbuf_isOp(&first->code, 0, "LABEL") && first->code.opCnt > 1)
+      cprop_hashFind(&labels, first->code.ops[1], first->code.opLens[1], b);
+  }
+
+  for (int b = 0; b < func->blockCnt; b++)
+  {
+    TCpropBlock *block = &func->blocks[b];
+    TCpropInstr *last = (block->end > block->first) ? &func->instrs[block->end - 1] : NULL;
+    int next = (b + 1 < func->blockCnt) ? b + 1 : CPROP_END;
+    if (last != NULL && cbuf_isOp(&last->code, 0, "RETURN"))
+      block->succs[block->succCnt++] = CPROP_END;
+    else if (last != NULL && cbuf_isBlockEnd(&last->code))
+    {
+      int target = (last->code.opCnt > 1) ? cprop_hashFind(&labels, last->code.ops[1], last->code.opLens[1], -1) : -1;
+      block->succs[block->succCnt++] = (target >= 0) ? target : CPROP_OUTSIDE;
+      if (!cbuf_isOp(&last->code, 0, "JUMP"))
+        block->succs[block->succCnt++] = next;
+    }
+    else
+      block->succs[block->succCnt++] = next;
+  }
+  cprop_hashFree(&labels);
+}
+
+// updates set of live variables by instruction, walking backward
+void cprop_stepBack(TCpropFunc *func, TCpropInstr *instr, unsigned *live)
+{
+  if (instr->isRemoved || instr->isCall)
+    return;
+  if (cbuf_isOp(&instr->code, 0, "CREATEFRAME"))
+  {
+    // previous temporary frame is thrown away
+    for (unsigned w = 0; w < func->words; w++)
+      live[w] &= ~func->tempVars[w];
+    return;
+  }
+  if (cbuf_isOp(&instr->code, 0, "POPFRAME"))
+  {
+    // end of function, caller reads only return value
+    cprop_setEndLive(func, live);
+    return;
+  }
+  if (cprop_isBarrier(instr))
+  {
+    memset(live, 0xff, sizeof(unsigned) * func->words);
+    return;
+  }
+  if (cprop_isDef(instr))
+    live[instr->vars[1] / 32] &= ~(1u << (instr->vars[1] % 32));
+  for (int i = cbuf_firstRead(&instr->code); i < instr->code.opCnt; i++)
+    if (instr->vars[i] >= 0)
+      live[instr->vars[i] / 32] |= 1u << (instr->vars[i] % 32);
+}
+
+// true if variable is in set
+bool cprop_isLive(unsigned *live, int var)
+{
+  return (live[var / 32] & (1u << (var % 32))) != 0;
+}
+
+// computes variables live on start and end of every block, all variables are live on end of function
+void cprop_computeLiveness(TCpropFunc *func)
+{
+  unsigned *live = mmng_safeMalloc(sizeof(unsigned) * (func->words + 1));
+  unsigned *endLive = mmng_safeMalloc(sizeof(unsigned) * (func->words + 1));
+  if (func->isOpenEnd)
+    memset(endLive, 0xff, sizeof(unsigned) * func->words);
+  else
+    cprop_setEndLive(func, endLive);
+  for (int b = 0; b < func->blockCnt; b++)
+    memset(func->blocks[b].liveIn, 0, sizeof(unsigned) * func->words);
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (int b = func->blockCnt - 1; b >= 0; b--)
+    {
+      TCpropBlock *block = &func->blocks[b];
+      memset(block->liveOut, 0, sizeof(unsigned) * func->words);
+      for (int s = 0; s < block->succCnt; s++)
+      {
+        if (block->succs[s] == CPROP_OUTSIDE)
+          memset(block->liveOut, 0xff, sizeof(unsigned) * func->words);
+        else if (block->succs[s] == CPROP_END)
+          for (unsigned w = 0; w < func->words; w++)
+            block->liveOut[w] |= endLive[w];
+        else
+          for (unsigned w = 0; w < func->words; w++)
+            block->liveOut[w] |= func->blocks[block->succs[s]].liveIn[w];
+      }
+      memcpy(live, block->liveOut, sizeof(unsigned) * func->words);
+      for (int i = block->end - 1; i >= block->first; i--)
+        cprop_stepBack(func, &func->instrs[i], live);
+      if (memcmp(live, block->liveIn, sizeof(unsigned) * func->words) != 0)
+      {
+        memcpy(block->liveIn, live, sizeof(unsigned) * func->words);
+        changed = true;
+      }
+    }
+  }
+  mmng_safeFree(live);
+  mmng_safeFree(endLive);
+}
+
+// forwards copies to reads of their destinations in every extended block, returns true if code was changed
+bool cprop_propagateCopies(TCpropFunc *func)
+{
+  bool changed = false;
+  // source of copy for every variable, NULL if variable is not a copy
+  const char **srcOps = mmng_safeMalloc(sizeof(char *) * (func->varCnt + 1));
+  unsigned *srcLens = mmng_safeMalloc(sizeof(unsigned) * (func->varCnt + 1));
+  int *srcVars = mmng_safeMalloc(sizeof(int) * (func->varCnt + 1));
+  int *copies = mmng_safeMalloc(sizeof(int) * (func->varCnt + 1)); // variables which are copies
+  for (int v = 0; v < func->varCnt; v++)
+    srcOps[v] = NULL;
+
+  int copyCnt = 0;
+  for (int b = 0; b < func->blockCnt; b++)
+  {
+    if (cbuf_isOp(&func->instrs[func->blocks[b].first].code, 0, "LABEL"))
+    {
+      // copies are kept only in extended basic block, block without label is entered only by fall through
+      for (int c = 0; c < copyCnt; c++)
+        srcOps[copies[c]] = NULL;
+      copyCnt = 0;
+    }
+    for (int i = func->blocks[b].first; i < func->blocks[b].end; i++)
+    {
+      TCpropInstr *instr = &func->instrs[i];
+      if (instr->isRemoved || instr->isCall)
+        continue; // called function cannot change variables of caller
+      if (cprop_isBarrier(instr))
+      {
+        for (int c = 0; c < copyCnt; c++)
+          srcOps[copies[c]] = NULL;
+        copyCnt = 0;
+        continue;
+      }
+      for (int j = cbuf_firstRead(&instr->code); j < instr->code.opCnt; j++)
+      {
+        int var = instr->vars[j];
+        if (var >= 0 && srcOps[var] != NULL)
+        {
+          instr->code.ops[j] = srcOps[var];
+          instr->code.opLens[j] = srcLens[var];
+          instr->vars[j] = srcVars[var];
+          changed = true;
+        }
+      }
+      if (!cbuf_hasDest(&instr->code) || instr->vars[1] < 0)
+        continue;
+      int dest = instr->vars[1];
+      if (cbuf_isOp(&instr->code, 0, "MOVE") && instr->code.opCnt == 3 && instr->vars[2] == dest)
+      {
+        instr->isRemoved = true;
+        changed = true;
+        continue;
+      }
+      // assignment invalidates copies of variable and copies from it
+      for (int c = 0; c < copyCnt; c++)
+        if (copies[c] == dest || srcVars[copies[c]] == dest)
+        {
+          srcOps[copies[c]] = NULL;
+          copies[c--] = copies[--copyCnt];
+        }
+      if (cbuf_isOp(&instr->code, 0, "MOVE") && instr->code.opCnt == 3)
+      {
+        srcOps[dest] = instr->code.ops[2];
+        srcLens[dest] = instr->code.opLens[2];
+        srcVars[dest] = instr->vars[2];
+        copies[copyCnt++] = dest;
+      }
+    }
+  }
+
+  mmng_safeFree(srcOps);
+  mmng_safeFree(srcLens);
+  mmng_safeFree(srcVars);
+  mmng_safeFree(copies);
+  return changed;
+}
+
+// value pushed to data stack and popped in the same block is moved directly (PUSHS src ... POPS dest -> MOVE dest src)
+bool cprop_pairStackOps(TCpropFunc *func)
+{
+  bool changed = false;
+  int *pushes = mmng_safeMalloc(sizeof(int) * (func->instrCnt + 1)); // not popped PUSHS instructions
+  for (int b = 0; b < func->blockCnt; b++)
+  {
+    int pushCnt = 0;
+    for (int i = func->blocks[b].first; i < func->blocks[b].end; i++)
+    {
+      TCpropInstr *instr = &func->instrs[i];
+      if (instr->isRemoved)
+        continue;
+      bool isPush = cbuf_isOp(&instr->code, 0, "PUSHS") && instr->code.opCnt == 2;
+      bool isPop = cbuf_isOp(&instr->code, 0, "POPS") && instr->code.opCnt == 2;
+      if (instr->isCall || cprop_isBarrier(instr) ||
+          (!isPush && !isPop && instr->code.ops[0][instr->code.opLens[0] - 1] == 'S'))
+        pushCnt = 0; // other instructions working with data stack
+      else if (isPush)
+        pushes[pushCnt++] = i;
+      else if (isPop && pushCnt > 0)
+      {
+        TCpropInstr *push = &func->instrs[pushes[--pushCnt]];
+        int src = push->vars[1];
+        bool isWritten = false;
+        for (int j = pushes[pushCnt] + 1; j < i && src >= 0 && !isWritten; j++)
+          isWritten = !func->instrs[j].isRemoved && !func->instrs[j].isCall && cbuf_hasDest(&func->instrs[j].code) &&
+            func->instrs[j].vars[1] == src;
+        if (isWritten)
+          continue;
+        push->isRemoved = true;
+        instr->code.ops[0] = "MOVE";
+        instr->code.opLens[0] = 4;
+        instr->code.ops[2] = push->code.ops[1];
+        instr->code.opLens[2] = push->code.opLens[1];
+        instr->vars[2] = src;
+        instr->code.opCnt = 3;
+        changed = true;
+      }
+    }
+  }
+  mmng_safeFree(pushes);
+  return changed;
+}
+
+// true if variable assigned by instruction on index from is not read after block before it is assigned again
+bool cprop_isLocalDef(TCpropFunc *func, TCpropBlock *block, int from, int var)
+{
+  for (int i = from + 1; i < block->end; i++)
+    if (!func->instrs[i].isRemoved && !func->instrs[i].isCall && cprop_isDef(&func->instrs[i]) &&
+        func->instrs[i].vars[1] == var)
+      return true;
+  return !cprop_isLive(block->liveOut, var);
+}
+
+// creates new auxiliary variable for value numbering, returns its index
+int cprop_newVar(TCpropFunc *func, bool simulate)
+{
+  int var = func->varCnt++;
+  func->tempVars[var / 32] |= 1u << (var % 32);
+  if (simulate)
+  {
+    func->varOps[var] = "TF@%V";
+    func->varLens[var] = 5;
+    return var;
+  }
+  func->newVars = mmng_safeRealloc(func->newVars, sizeof(char *) * (func->newVarCnt + 1));
+  char *name = mmng_safeMalloc(sizeof(char) * 20);
+  sprintf(name, "TF@%%V%d", func->newVarCnt);
+  func->newVars[func->newVarCnt++] = name;
+  func->varOps[var] = name;
+  func->varLens[var] = strlen(name);
+  return var;
+}
+
+// value which is already held by variable is not computed again, value numbers are valid in extended basic blocks
+// (successors entered only by fall), temporary variable holding value is renamed by next assignment if marked
+// in renames, all renames are done and needed ones are marked in simulation
+bool cprop_numberValues(TCpropFunc *func, bool *renames, bool simulate)
+{
+  bool changed = false;
+  int varCap = func->varCap;
+  int *varVNs = mmng_safeMalloc(sizeof(int) * varCap);      // value numbers of variables, 0 if unknown
+  int *renamedTo = mmng_safeMalloc(sizeof(int) * varCap);   // actual name of renamed variable, -1 if it is not renamed
+  int *renamedVars = mmng_safeMalloc(sizeof(int) * varCap);
+  int *protPrev = mmng_safeMalloc(sizeof(int) * (func->instrCnt + 1)); // previous rename keeping the same value
+  TCpropValue *values = mmng_safeMalloc(sizeof(TCpropValue) * CPROP_MAX_VALUES);
+  memset(varVNs, 0, sizeof(int) * varCap);
+  for (int v = 0; v < varCap; v++)
+    renamedTo[v] = -1;
+  int valueCnt = 0;
+  int nextVN = 1;
+
+  for (int b = 0; b < func->blockCnt; b++)
+  {
+    TCpropBlock *block = &func->blocks[b];
+    int renamedCnt = 0;
+    if (cbuf_isOp(&func->instrs[block->first].code, 0, "LABEL"))
+    {
+      valueCnt = 0; // block is entered by jump
+      memset(varVNs, 0, sizeof(int) * varCap);
+    }
+    for (int i = block->first; i < block->end; i++)
+    {
+      TCpropInstr *instr = &func->instrs[i];
+      if (instr->isRemoved || instr->isCall)
+        continue; // called function cannot change variables of caller
+      if (cprop_isBarrier(instr))
+      {
+        valueCnt = 0;
+        memset(varVNs, 0, sizeof(int) * varCap);
+        continue;
+      }
+      int vns[CBUF_MAX_OPERANDS] = { 0, 0, 0, 0 };
+      for (int j = cbuf_firstRead(&instr->code); j < instr->code.opCnt; j++)
+      {
+        int var = instr->vars[j];
+        if (var < 0)
+          continue;
+        if (renamedTo[var] >= 0)
+        {
+          var = instr->vars[j] = renamedTo[var];
+          instr->code.ops[j] = func->varOps[var];
+          instr->code.opLens[j] = func->varLens[var];
+        }
+        if (varVNs[var] == 0)
+          varVNs[var] = nextVN++;
+        vns[j] = varVNs[var];
+      }
+      if (!cbuf_hasDest(&instr->code) || instr->vars[1] < 0)
+        continue;
+      int dest = instr->vars[1];
+      if (renamedTo[dest] >= 0 && cprop_isDef(instr))
+        renamedTo[dest] = -1; // new value is assigned to original variable again
+
+      TCpropValue *value = NULL;
+      for (int v = 0; v < valueCnt && value == NULL && cprop_isValueOp(instr); v++)
+        if (cprop_computesValue(instr, vns, &values[v]))
+          value = &values[v];
+      if (value != NULL && varVNs[value->holder] == value->vn)
+      {
+        // value is still held by variable
+        for (int p = value->lastProt; simulate && p >= 0; p = protPrev[p])
+          renames[p] = true;
+        if (value->holder == dest)
+          instr->isRemoved = true;
+        else
+        {
+          instr->code.ops[0] = "MOVE";
+          instr->code.opLens[0] = 4;
+          instr->code.ops[2] = func->varOps[value->holder];
+          instr->code.opLens[2] = func->varLens[value->holder];
+          instr->vars[2] = value->holder;
+          instr->code.opCnt = 3;
+        }
+        varVNs[dest] = value->vn;
+        changed = true;
+        continue;
+      }
+      int vn = (value != NULL) ? value->vn : nextVN++;
+      if (cbuf_isOp(&instr->code, 0, "MOVE") && instr->code.opCnt == 3 && instr->vars[2] >= 0)
+        vn = vns[2];
+
+      // assignment to temporary variable holding computed value goes to new variable
+      int held = -1;
+      for (int v = 0; v < valueCnt && held < 0 && varVNs[dest] != 0; v++)
+        if (values[v].holder == dest && values[v].vn == varVNs[dest])
+          held = v;
+      if (held >= 0 && (simulate || renames[i]) && cprop_isDef(instr) && (func->tempVars[dest / 32] & (1u << (dest % 32))) &&
+          func->varCnt < varCap && cprop_isLocalDef(func, block, i, dest))
+      {
+        int newVar = cprop_newVar(func, simulate);
+        instr->code.ops[1] = func->varOps[newVar];
+        instr->code.opLens[1] = func->varLens[newVar];
+        instr->vars[1] = newVar;
+        renamedTo[dest] = newVar;
+        renamedVars[renamedCnt++] = dest;
+        protPrev[i] = values[held].lastProt;
+        values[held].lastProt = i;
+        dest = newVar;
+      }
+      varVNs[dest] = vn;
+
+      if (value != NULL)
+      {
+        value->holder = dest; // value was computed again
+        value->lastProt = -1;
+      }
+      else if (cprop_isValueOp(instr))
+      {
+        if (valueCnt == CPROP_MAX_VALUES)
+        {
+          // values which are not held anymore are forgotten
+          int cnt = 0;
+          for (int v = 0; v < valueCnt; v++)
+            if (varVNs[values[v].holder] == values[v].vn)
+              values[cnt++] = values[v];
+          valueCnt = cnt;
+        }
+        if (valueCnt < CPROP_MAX_VALUES)
+        {
+          value = &values[valueCnt++];
+          value->opCnt = instr->code.opCnt;
+          for (int j = 0; j < instr->code.opCnt; j++)
+          {
+            value->ops[j] = instr->code.ops[j];
+            value->opLens[j] = instr->code.opLens[j];
+            value->vns[j] = vns[j];
+          }
+          value->vn = vn;
+          value->holder = dest;
+          value->lastProt = -1;
+        }
+      }
+    }
+    // renamed variables are not read after block
+    for (int r = 0; r < renamedCnt; r++)
+      renamedTo[renamedVars[r]] = -1;
+  }
+
+  mmng_safeFree(varVNs);
+  mmng_safeFree(renamedTo);
+  mmng_safeFree(renamedVars);
+  mmng_safeFree(protPrev);
+  mmng_safeFree(values);
+  return changed;
+}
+
+// value numbering, temporary variables are renamed only if their values are used again
+bool cprop_eliminateCommonValues(TCpropFunc *func, bool canRename)
+{
+  bool *renames = mmng_safeMalloc(sizeof(bool) * (func->instrCnt + 1));
+  memset(renames, 0, sizeof(bool) * (func->instrCnt + 1));
+  if (canRename)
+  {
+    // simulation runs on copy of instructions
+    TCpropInstr *instrs = func->instrs;
+    int varCnt = func->varCnt;
+    func->instrs = mmng_safeMalloc(sizeof(TCpropInstr) * (func->instrCnt + 1));
+    memcpy(func->instrs, instrs, sizeof(TCpropInstr) * func->instrCnt);
+    cprop_numberValues(func, renames, true);
+    mmng_safeFree(func->instrs);
+    func->instrs = instrs;
+    for (int v = varCnt; v < func->varCnt; v++)
+      func->tempVars[v / 32] &= ~(1u << (v % 32));
+    func->varCnt = varCnt;
+  }
+  bool changed = cprop_numberValues(func, renames, false);
+  mmng_safeFree(renames);
+  return changed;
+}
+
+// true if instruction converts numeric type of its operand
+bool cprop_isConversion(TCpropInstr *instr)
+{
+  return instr->code.opCnt == 3 && (cbuf_isOp(&instr->code, 0, "INT2FLOAT") ||
+    cbuf_isOp(&instr->code, 0, "FLOAT2INT") || cbuf_isOp(&instr->code, 0, "FLOAT2R2EINT") ||
+    cbuf_isOp(&instr->code, 0, "FLOAT2R2OINT"));
+}
+
+// replaces source operand of instruction by new constant text, instruction becomes MOVE
+void cprop_setConstMove(TCpropFunc *func, TCpropInstr *instr, const char *text)
+{
+  func->texts = mmng_safeRealloc(func->texts, sizeof(char *) * (func->textCnt + 1));
+  char *copy = mmng_safeMalloc(sizeof(char) * (strlen(text) + 1));
+  strcpy(copy, text);
+  func->texts[func->textCnt++] = copy;
+  instr->code.ops[0] = "MOVE";
+  instr->code.opLens[0] = 4;
+  instr->code.ops[2] = copy;
+  instr->code.opLens[2] = strlen(copy);
+  instr->vars[2] = -1;
+}
+
+// conversions of constants forwarded to their operands are done in compile time, returns true if code was changed
+bool cprop_foldConversions(TCpropFunc *func)
+{
+  bool changed = false;
+  char text[64];
+  char literal[64];
+  for (int i = 0; i < func->instrCnt; i++)
+  {
+    TCpropInstr *instr = &func->instrs[i];
+    if (instr->isRemoved || instr->isCall || !cprop_isConversion(instr) || instr->code.opLens[2] >= sizeof(literal))
+      continue;
+    memcpy(literal, instr->code.ops[2], instr->code.opLens[2]);
+    literal[instr->code.opLens[2]] = '\0';
+    char *end = NULL;
+    if (cbuf_isOp(&instr->code, 0, "INT2FLOAT") && cbuf_opStartsWith(&instr->code, 2, "int@"))
+    {
+      long value = strtol(literal + 4, &end, 10);
+      sprintf(text, "float@%g", (double)value);
+      if (*end != '\0' || strtod(text + 6, NULL) != (double)value)
+        continue; // constant would not be exact
+    }
+    else if (!cbuf_isOp(&instr->code, 0, "INT2FLOAT") && cbuf_opStartsWith(&instr->code, 2, "float@"))
+    {
+      double value = strtod(literal + 6, &end);
+      if (cbuf_isOp(&instr->code, 0, "FLOAT2INT"))
+        value = trunc(value);
+      else if (cbuf_isOp(&instr->code, 0, "FLOAT2R2EINT"))
+        value = rint(value); // half to even in default rounding mode
+      else
+        value = round(value);
+      if (*end != '\0' || !(value >= INT_MIN && value <= INT_MAX))
+        continue; // error of conversion is left to run time
+      sprintf(text, "int@%d", (int)value);
+    }
+    else
+      continue;
+    cprop_setConstMove(func, instr, text);
+    changed = true;
+  }
+  return changed;
+}
+
+// frees basic blocks of function
+void cprop_freeBlocks(TCpropFunc *func)
+{
+  for (int b = 0; b < func->blockCnt; b++)
+  {
+    mmng_safeFree(func->blocks[b].liveIn);
+    mmng_safeFree(func->blocks[b].liveOut);
+  }
+  if (func->blocks != NULL)
+    mmng_safeFree(func->blocks);
+  func->blocks = NULL;
+  func->blockCnt = 0;
+}
+
+// updates set of available conversions by instruction, sites are indexes of conversions for every instruction
+// (-1 if instruction is not a cached conversion) and kills are sets of conversions invalidated by assignment
+void cprop_stepConvs(TCpropFunc *func, int i, int *sites, unsigned *kills, unsigned *avail)
+{
+  TCpropInstr *instr = &func->instrs[i];
+  if (instr->isRemoved || instr->isCall)
+    return;
+  if (cprop_isBarrier(instr))
+    *avail = 0;
+  if (cbuf_hasDest(&instr->code) && instr->vars[1] >= 0)
+    *avail &= ~kills[instr->vars[1]];
+  if (sites[i] >= 0)
+    *avail |= 1u << sites[i];
+}
+
+// variable converted again on every path is converted once to typed copy (auxiliary variable of temporary frame),
+// CONV dest var -> CONV copy var, MOVE dest copy; later conversions are only moves of the copy (MOVE dest copy)
+bool cprop_cacheConversions(TCpropFunc *func)
+{
+  int *sites = mmng_safeMalloc(sizeof(int) * (func->instrCnt + 1));
+  unsigned *kills = mmng_safeMalloc(sizeof(unsigned) * (func->varCnt + 1));
+  int convInstrs[CPROP_MAX_CONVS]; // first instruction of every distinct conversion
+  int convCnt = 0;
+  memset(kills, 0, sizeof(unsigned) * (func->varCnt + 1));
+
+  // distinct conversions of variables
+  for (int i = 0; i < func->instrCnt; i++)
+  {
+    TCpropInstr *instr = &func->instrs[i];
+    sites[i] = -1;
+    if (instr->isRemoved || instr->isCall || !cprop_isConversion(instr) || instr->vars[1] < 0 || instr->vars[2] < 0 ||
+        instr->vars[1] == instr->vars[2])
+      continue;
+    for (int c = 0; c < convCnt && sites[i] < 0; c++)
+      if (instr->vars[2] == func->instrs[convInstrs[c]].vars[2] &&
+          cprop_isSameText(instr->code.ops[0], instr->code.opLens[0], func->instrs[convInstrs[c]].code.ops[0],
+                           func->instrs[convInstrs[c]].code.opLens[0]))
+        sites[i] = c;
+    if (sites[i] < 0 && convCnt < CPROP_MAX_CONVS)
+    {
+      convInstrs[convCnt] = i;
+      kills[instr->vars[2]] |= 1u << convCnt;
+      sites[i] = convCnt++;
+    }
+  }
+
+  // available conversions on start of every block, intersection over predecessors
+  unsigned *availIn = mmng_safeMalloc(sizeof(unsigned) * (func->blockCnt + 1));
+  unsigned *availOut = mmng_safeMalloc(sizeof(unsigned) * (func->blockCnt + 1));
+  for (int b = 0; b < func->blockCnt; b++)
+    availOut[b] = ~0u;
+  bool isStable = convCnt == 0;
+  while (!isStable)
+  {
+    isStable = true;
+    for (int b = 0; b < func->blockCnt; b++)
+    {
+      availIn[b] = (b == 0) ? 0 : ~0u;
+      for (int p = 0; p < func->blockCnt; p++)
+        for (int s = 0; s < func->blocks[p].succCnt; s++)
+          if (func->blocks[p].succs[s] == b)
+            availIn[b] &= availOut[p];
+      unsigned avail = availIn[b];
+      for (int i = func->blocks[b].first; i < func->blocks[b].end; i++)
+        cprop_stepConvs(func, i, sites, kills, &avail);
+      if (avail != availOut[b])
+      {
+        availOut[b] = avail;
+        isStable = false;
+      }
+    }
+  }
+
+  // redundant conversions, only conversions with some redundant instruction are cached
+  bool *isRedundant = mmng_safeMalloc(sizeof(bool) * (func->instrCnt + 1));
+  unsigned used = 0;
+  for (int b = 0; b < func->blockCnt && convCnt > 0; b++)
+  {
+    unsigned avail = availIn[b];
+    for (int i = func->blocks[b].first; i < func->blocks[b].end; i++)
+    {
+      isRedundant[i] = sites[i] >= 0 && (avail & (1u << sites[i])) != 0;
+      if (isRedundant[i])
+        used |= 1u << sites[i];
+      cprop_stepConvs(func, i, sites, kills, &avail);
+    }
+  }
+
+  // typed copies
+  int copies[CPROP_MAX_CONVS];
+  int insertCnt = 0;
+  for (int c = 0; c < convCnt; c++)
+  {
+    copies[c] = -1;
+    if ((used & (1u << c)) != 0 && func->varCnt < func->varCap)
+      copies[c] = cprop_newVar(func, false);
+  }
+  for (int i = 0; i < func->instrCnt; i++)
+    if (sites[i] >= 0 && copies[sites[i]] >= 0 && !isRedundant[i])
+      insertCnt++;
+
+  if (insertCnt > 0 || used != 0)
+  {
+    TCpropInstr *instrs = mmng_safeMalloc(sizeof(TCpropInstr) * (func->instrCnt + insertCnt + 1));
+    int cnt = 0;
+    for (int i = 0; i < func->instrCnt; i++)
+    {
+      TCpropInstr *instr = &instrs[cnt++];
+      *instr = func->instrs[i];
+      if (sites[i] < 0 || copies[sites[i]] < 0)
+        continue;
+      int c = copies[sites[i]];
+      if (isRedundant[i])
+      {
+        instr->code.ops[0] = "MOVE";
+        instr->code.opLens[0] = 4;
+        instr->code.ops[2] = func->varOps[c];
+        instr->code.opLens[2] = func->varLens[c];
+        instr->vars[2] = c;
+      }
+      else
+      {
+        TCpropInstr *move = &instrs[cnt++];
+        *move = *instr;
+        move->code.ops[0] = "MOVE";
+        move->code.opLens[0] = 4;
+        move->code.ops[2] = func->varOps[c];
+        move->code.opLens[2] = func->varLens[c];
+        move->vars[2] = c;
+        instr->code.ops[1] = func->varOps[c];
+        instr->code.opLens[1] = func->varLens[c];
+        instr->vars[1] = c;
+      }
+    }
+    mmng_safeFree(func->instrs);
+    func->instrs = instrs;
+    func->instrCnt = cnt;
+    cprop_freeBlocks(func);
+    cprop_buildBlocks(func);
+  }
+
+  mmng_safeFree(sites);
+  mmng_safeFree(kills);
+  mmng_safeFree(availIn);
+  mmng_safeFree(availOut);
+  mmng_safeFree(isRedundant);
+  return used != 0;
+}
+
+// instruction computing temporary value which is only moved to variable gets the variable as destination
+bool cprop_retargetMoves(TCpropFunc *func)
+{
+  bool changed = false;
+  // true for MOVE whose source is not read after it
+  bool *srcDead = mmng_safeMalloc(sizeof(bool) * (func->instrCnt + 1));
+  unsigned *live = mmng_safeMalloc(sizeof(unsigned) * (func->words + 1));
+
+  for (int b = 0; b < func->blockCnt; b++)
+  {
+    TCpropBlock *block = &func->blocks[b];
+    memcpy(live, block->liveOut, sizeof(unsigned) * func->words);
+    for (int i = block->end - 1; i >= block->first; i--)
+    {
+      TCpropInstr *instr = &func->instrs[i];
+      srcDead[i] = !instr->isRemoved && !instr->isCall && cbuf_isOp(&instr->code, 0, "MOVE") &&
+        instr->code.opCnt == 3 &&
+        instr->vars[1] >= 0 && instr->vars[2] >= 0 && !cprop_isLive(live, instr->vars[2]);
+      cprop_stepBack(func, instr, live);
+    }
+
+    for (int j = block->first; j < block->end; j++)
+    {
+      if (!srcDead[j])
+        continue;
+      TCpropInstr *move = &func->instrs[j];
+      int dest = move->vars[1];
+      int src = move->vars[2];
+      for (int i = j - 1; i >= block->first; i--)
+      {
+        TCpropInstr *instr = &func->instrs[i];
+        if (instr->isRemoved || instr->isCall)
+          continue;
+        if (cprop_isBarrier(instr))
+          break;
+        if (cprop_isDef(instr) && instr->vars[1] == src && !cbuf_isOp(&instr->code, 0, "DEFVAR"))
+        {
+          instr->code.ops[1] = move->code.ops[1];
+          instr->code.opLens[1] = move->code.opLens[1];
+          instr->vars[1] = dest;
+          move->isRemoved = true;
+          changed = true;
+          break;
+        }
+        if (cprop_refersTo(instr, src) || cprop_refersTo(instr, dest))
+          break;
+      }
+    }
+  }
+
+  mmng_safeFree(srcDead);
+  mmng_safeFree(live);
+  return changed;
+}
+
+// deletes instructions without side effect whose result is not read, returns true if code was changed
+bool cprop_removeDeadStores(TCpropFunc *func)
+{
+  bool changed = false;
+  unsigned *live = mmng_safeMalloc(sizeof(unsigned) * (func->words + 1));
+  for (int b = 0; b < func->blockCnt; b++)
+  {
+    TCpropBlock *block = &func->blocks[b];
+    memcpy(live, block->liveOut, sizeof(unsigned) * func->words);
+    for (int i = block->end - 1; i >= block->first; i--)
+    {
+      TCpropInstr *instr = &func->instrs[i];
+      if (!instr->isRemoved && !instr->isCall && cbuf_isPure(&instr->code) && instr->vars[1] >= 0 &&
+          !cprop_isLive(live, instr->vars[1]))
+      {
+        instr->isRemoved = true;
+        changed = true;
+      }
+      else
+        cprop_stepBack(func, instr, live);
+    }
+  }
+  mmng_safeFree(live);
+  return changed;
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+// Optimizes code of one function or its block
+char *cprop_optimize(const char *code, bool isOpenEnd, char **defs, unsigned *removed)
+{
+  TCpropFunc func;
+  func.isOpenEnd = isOpenEnd;
+  func.instrCnt = cprop_parse(code, &func.instrs);
+  cprop_markCalls(&func);
+  cprop_indexVars(&func);
+  cprop_buildBlocks(&func);
+
+  for (int round = 0; round < CPROP_MAX_ROUNDS; round++)
+  {
+    bool changed = cprop_pairStackOps(&func);
+    // moves are retargeted before copies are forwarded, forwarded copy of temporary variable would keep it live
+    cprop_computeLiveness(&func);
+    changed = cprop_retargetMoves(&func) || changed;
+    changed = cprop_propagateCopies(&func) || changed;
+    cprop_computeLiveness(&func);
+    changed = cprop_foldConversions(&func) || changed;
+    changed = cprop_eliminateCommonValues(&func, defs != NULL) || changed;
+    if (defs != NULL)
+    {
+      cprop_computeLiveness(&func);
+      changed = cprop_cacheConversions(&func) || changed;
+    }
+    cprop_computeLiveness(&func);
+    changed = cprop_removeDeadStores(&func) || changed;
+    if (!changed)
+      break;
+  }
+
+  // print of remaining instructions
+  unsigned len = 0;
+  unsigned removedCnt = 0;
+  for (int i = 0; i < func.instrCnt; i++)
+  {
+    if (func.instrs[i].isRemoved)
+      removedCnt++;
+    else
+      for (int j = 0; j < func.instrs[i].code.opCnt; j++)
+        len += func.instrs[i].code.opLens[j] + 1;
+  }
+  char *result = mmng_safeMalloc(sizeof(char) * (len + 1));
+  char *act = result;
+  for (int i = 0; i < func.instrCnt; i++)
+  {
+    TCpropInstr *instr = &func.instrs[i];
+    if (instr->isRemoved)
+      continue;
+    for (int j = 0; j < instr->code.opCnt; j++)
+    {
+      memcpy(act, instr->code.ops[j], instr->code.opLens[j]);
+      act += instr->code.opLens[j];
+      *act++ = (j + 1 < instr->code.opCnt) ? ' ' : '\n';
+    }
+  }
+  *act = '\0';
+  if (removed != NULL)
+    *removed = removedCnt;
+
+  // definitions of new auxiliary variables
+  if (defs != NULL)
+  {
+    *defs = mmng_safeMalloc(sizeof(char) * (func.newVarCnt * 28 + 1));
+    (*defs)[0] = '\0';
+    for (int v = 0; v < func.newVarCnt; v++)
+    {
+      strcat(*defs, "DEFVAR ");
+      strcat(*defs, func.newVars[v]);
+      strcat(*defs, "\n");
+      mmng_safeFree(func.newVars[v]);
+    }
+  }
+  if (func.newVars != NULL)
+    mmng_safeFree(func.newVars);
+  for (int t = 0; t < func.textCnt; t++)
+    mmng_safeFree(func.texts[t]);
+  if (func.texts != NULL)
+    mmng_safeFree(func.texts);
+
+  cprop_freeBlocks(&func);
+  if (func.instrs != NULL)
+    mmng_safeFree(func.instrs);
+  cprop_hashFree(&func.vars);
+  mmng_safeFree(func.tempVars);
+  mmng_safeFree(func.varOps);
+  mmng_safeFree(func.varLens);
+  return result;
+}
+
+char *cprop_optimizeCode(const char *code, char **defs, unsigned *removed)
+{
+  return cprop_optimize(code, false, defs, removed);
+}
+
+char *cprop_optimizeBlock(const char *code, char **defs, unsigned *removed)
+{
+  return cprop_optimize(code, true, defs, removed);
+}
@@ -0,0 +1,61 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    copyprop.h
+ * \brief   Copy propagation and dead-store elimination
+ *
+ * Package runs local dataflow optimizations on code of one function. In every basic block copies
+ * (MOVE var symb) are forwarded to later reads of their destination. Instruction which computes
+ * value of temporary variable only moved to other variable gets that variable as its destination
+ * directly and the move is deleted. Instructions without side effect assigning variable which is not
+ * read anymore are deleted. Liveness of variables is computed over whole control flow of function.
+ *
+ * Values of arithmetic, relational and conversion instructions are numbered over extended basic
+ * blocks (block and its successors entered only by fall through). Value which is still held by some
+ * variable is not computed again but moved from that variable. When generated code overwrites
+ * temporary variable holding value which is used again, the new assignment gets new auxiliary
+ * variable of temporary frame TF@%V<n> instead. Calls do not invalidate values, called function
+ * cannot change variables of caller.
+ *
+ * Numeric conversions of constants are done in compile time. Variable converted again while the
+ * conversion is available on every path is converted only once to its typed copy (TF@%V<n>).
+ *
+ * Call sequences (PUSHFRAME, CREATEFRAME, parameters, CALL, PUSHS TF@%retval, POPFRAME) are left
+ * untouched, their operands refer to frame of called function.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _CopyProp
+#define _CopyProp
+
+/**
+ * Optimizes code of one function
+ *
+ * \param code code of function
+ * \param defs output of definitions of new auxiliary variables of temporary frame, if NULL no
+ *             variables are created
+ * \param removed output of count of deleted instructions, can be NULL
+ * \returns optimized code
+ * \note Memory of result is allocated here and free has to be called.
+ */
+char *cprop_optimizeCode(const char *code, char **defs, unsigned *removed);
+
+/**
+ * Optimizes block of code of function, which is followed by rest of function
+ *
+ * Code has to be complete sequence of statements (jumps do not leave it), all variables are live
+ * on its end. Auxiliary variables are numbered from TF@%V0 as in cprop_optimizeCode().
+ *
+ * \param code block of code
+ * \param defs output of definitions of new auxiliary variables of temporary frame, if NULL no
+ *             variables are created
+ * \param removed output of count of deleted instructions, can be NULL
+ * \returns optimized code
+ * \note Memory of result is allocated here and free has to be called.
+ */
+char *cprop_optimizeBlock(const char *code, char **defs, unsigned *removed);
+
+#endif // _CopyProp
@@ -11,20 +11,23 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <ctype.h>
 #include "grammar.h"
 #include "scanner.h"
 #include "apperr.h"
 #include "mmng.h"
 #include "symtable.h"
+#include "constpool.h"
 #include "exprsemanticanalyzer.h"
 #include "syntaxanalyzer.h"
 #include "utils.h"
+#include "compilerctx.h"
 
 // variable for passing the symbol with the converted value between the functions
 // is used for example for expression: A(int) = A(int) + A(double)
 // int variable A is converted to double and then is
-TSymbol convertedSymbol;
-int isMyTemp = 0;
+// it is part of actual compiler context
+#define convertedSymbol (GLBCompilerCtx->convertedSymbol)
 
 /**
 * Returns 0 if symbols are out of range or relation between symbols is not defined, otherwise 1
@@ -79,32 +82,14 @@ int syntx_getPrecedence(EGrSymb stackSymb, EGrSymb inputSymb, EGrSymb *precRtrn)
 }
 
 /**
- * Deeply copies token
+ * Creates expression token with constant from pool of constants
  */
-SToken syntx_deepCopyToken(SToken *token){
-  if (token->symbol->type == symtFuction)
-    apperr_runtimeError("Can not make deep copy of function symbol");
-
-  SToken tokenCopy;
-
-  tokenCopy.dataType = token->dataType;
-  tokenCopy.type = token->type;
-
-  tokenCopy.symbol = symbt_getUniqeTmpSymb();
-  if (token->symbol->type == symtConstant)
-  {
-    if (token->symbol->dataType == dtString)
-      tokenCopy.symbol->data.stringVal = util_StrHardCopy(token->symbol->data.stringVal);
-    else
-      tokenCopy.symbol->data = token->symbol->data;
-  }
-
-  tokenCopy.symbol->dataType = token->symbol->dataType;
-  mmng_safeFree(tokenCopy.symbol->ident);
-  tokenCopy.symbol->ident = util_StrHardCopy(token->symbol->ident);
-  tokenCopy.symbol->type = token->symbol->type;
-
-  return tokenCopy;
+SToken syntx_constToken(DataType dataType, Data data){
+  SToken token;
+  token.type = NT_EXPR;
+  token.dataType = dataType;
+  token.symbol = cpool_get(cpool_insert(dataType, data));
+  return token;
 }
 
 /**
@@ -134,8 +119,8 @@ double syntx_intToDouble(int inputNum){
  */
 void syntx_intToDoubleToken(SToken *token){
 
-  if(token->symbol->type == symtConstant){ // converts only constant symbols
-    token->symbol->data.doubleVal = syntx_intToDouble(token->symbol->data.intVal);
+  if(token->symbol->type == symtConstant){ // constant is replaced by converted constant from pool
+    token->symbol = cpool_double(syntx_intToDouble(token->symbol->data.intVal));
   }else if(token->symbol->type == symtVariable){ // converts variable
 
     // changes copied symbol to converted symbol
@@ -146,9 +131,6 @@ void syntx_intToDoubleToken(SToken *token){
 
     token->symbol = temp.symbol; // change symbol of token to converted symbol
   }
-
-  token->symbol->dataType = dtFloat;
-
 }
 
 /**
@@ -156,8 +138,8 @@ void syntx_intToDoubleToken(SToken *token){
  */
 void syntx_doubleToIntToken(SToken *token){
 
-  if(token->symbol->type == symtConstant){ // converts only constant symbols
-    token->symbol->data.intVal = syntx_doubleToInt(token->symbol->data.doubleVal);
+  if(token->symbol->type == symtConstant){ // constant is replaced by converted constant from pool
+    token->symbol = cpool_int(syntx_doubleToInt(token->symbol->data.doubleVal));
   }else if(token->symbol->type == symtVariable){ // converts variable
 
     // changes copied symbol to converted symbol
@@ -168,9 +150,6 @@ void syntx_doubleToIntToken(SToken *token){
 
     token->symbol = temp.symbol; // change symbol of token to converted symbol
   }
-
-  token->symbol->dataType = dtInt;
-
 }
 
 /**
@@ -378,25 +357,104 @@ int syntx_checkDataTypeOfBool(SToken *boolOperand){
 }
 
 /**
- * Optimalization function - do operation with constants (+, -, *, /, \, + for concat strings and extra =, <> with bool - bool)
- * Always returns filled token, token.type = NT_EXPR, token.symbol->type
- * if everythng is OK, is setted token.symbol->dataType, token.symbol->data
- * else token.symbol->dataType = dtUnspecified and wrong token.symbol->data -> ends program with typeCompatibilityErr
+ * True if operator is relational (<, >, <=, >=, =, <>)
  */
-SToken syntx_doArithmeticOp(SToken *leftOperand, SToken *oper, SToken *rightOperand){
+int syntx_isRelationalOp(SToken *oper){
+  switch(oper->type){
+    case opLes:
+    case opGrt:
+    case opLessEq:
+    case opGrtEq:
+    case opEq:
+    case opNotEq:
+      return 1;
+    default:
+      return 0;
+  }
+}
 
-  SToken token;
-  token.type = NT_EXPR;
-  token.symbol = symbt_getUniqeTmpSymb();
-  token.symbol->type = symtConstant;
-  token.symbol->dataType = dtUnspecified;
+/**
+ * Reads one character of string constant in output code format (decodes escape sequence \ddd)
+ * Returns decoded character and moves str behind it
+ */
+unsigned char syntx_readStrChar(const char **str){
+  const char *act = *str;
+  if(act[0] == '\\' && isdigit(act[1]) && isdigit(act[2]) && isdigit(act[3])){
+    *str += 4;
+    return (act[1] - '0') * 100 + (act[2] - '0') * 10 + (act[3] - '0');
+  }
+  *str += 1;
+  return act[0];
+}
+
+/**
+ * Compares two string constants by ordinal values of characters as interpret does
+ * Returns negative number, zero or positive number if str1 is less, equal or greater than str2
+ */
+int syntx_compareStrings(const char *str1, const char *str2){
+  while(*str1 != '\0' && *str2 != '\0'){
+    unsigned char char1 = syntx_readStrChar(&str1);
+    unsigned char char2 = syntx_readStrChar(&str2);
+    if(char1 != char2){
+      return char1 - char2;
+    }
+  }
+  return (*str1 != '\0') - (*str2 != '\0');
+}
+
+/**
+ * Optimalization function - evaluates relational operator with two constants
+ * Numeric operands are compared as doubles if one of them is double,
+ * strings are compared lexicographically and bool operands only with =, <>.
+ * Result is bool, on wrong operands ends program with typeCompatibilityErr
+ */
+void syntx_doRelationalOp(SToken *leftOperand, SToken *oper, SToken *rightOperand, DataType *resType, Data *resData){
+  TSymbol left = leftOperand->symbol;
+  TSymbol right = rightOperand->symbol;
+  int cmp = 0;
+
+  if(left->dataType == dtInt && right->dataType == dtInt){  // int - int
+    cmp = (left->data.intVal > right->data.intVal) - (left->data.intVal < right->data.intVal);
+  }else if((left->dataType == dtInt || left->dataType == dtFloat) && (right->dataType == dtInt || right->dataType == dtFloat)){ // -> double - double
+    double leftVal = (left->dataType == dtInt) ? syntx_intToDouble(left->data.intVal) : left->data.doubleVal;
+    double rightVal = (right->dataType == dtInt) ? syntx_intToDouble(right->data.intVal) : right->data.doubleVal;
+    cmp = (leftVal > rightVal) - (leftVal < rightVal);
+  }else if(left->dataType == dtString && right->dataType == dtString){  // string - string
+    cmp = syntx_compareStrings(left->data.stringVal, right->data.stringVal);
+  }else if(left->dataType == dtBool && right->dataType == dtBool && (oper->type == opEq || oper->type == opNotEq)){ // bool - bool
+    cmp = left->data.boolVal != right->data.boolVal;
+  }else{
+    scan_raiseCodeError(typeCompatibilityErr, "Error during arithmetic or relational operation.", NULL);  // prints error
+  }
+
+  *resType = dtBool;
+  switch(oper->type){
+    case opLes: resData->boolVal = cmp < 0; break;
+    case opGrt: resData->boolVal = cmp > 0; break;
+    case opLessEq: resData->boolVal = cmp <= 0; break;
+    case opGrtEq: resData->boolVal = cmp >= 0; break;
+    case opEq: resData->boolVal = cmp == 0; break;
+    case opNotEq: resData->boolVal = cmp != 0; break;
+    default: break;
+  }
+}
+
+/**
+ * Optimalization function - do operation with constants (+, -, *, /, \, + for concat strings, relational operators and boolean operators)
+ * Always returns filled token, token.type = NT_EXPR, token.symbol is constant from pool of constants
+ * if operation with given operands is not possible -> ends program with typeCompatibilityErr
+ */
+SToken syntx_doArithmeticOp(SToken *leftOperand, SToken *oper, SToken *rightOperand){
 
+  DataType resType = dtUnspecified;
+  Data resData;
 
-  SToken leftOperandCopy = syntx_deepCopyToken(leftOperand);
+  // operands are copied, conversions replaces symbols of copies so original tokens stays untouched
+  SToken leftOperandCopy = *leftOperand;
 
   if(rightOperand != NULL){
 
-    SToken rightOperandCopy = syntx_deepCopyToken(rightOperand);
+    SToken rightOperandCopy = *rightOperand;
 
 
     if(leftOperandCopy.symbol->type == symtConstant && rightOperandCopy.symbol->type == symtConstant){  // if operation is possible to do
@@ -411,23 +469,25 @@ SToken syntx_doArithmeticOp(SToken *leftOperand, SToken *oper, SToken *rightOper
       }
 
       // by dataType choose right type from union, do implicit conversion and do operation
-      if(leftOperandCopy.symbol->dataType == dtInt && rightOperandCopy.symbol->dataType == dtInt){
+      if(syntx_isRelationalOp(oper)){ // relational operators results always in bool
+        syntx_doRelationalOp(&leftOperandCopy, oper, &rightOperandCopy, &resType, &resData);
+      }else if(leftOperandCopy.symbol->dataType == dtInt && rightOperandCopy.symbol->dataType == dtInt){
 
-        token.symbol->dataType = dtInt;
+        resType = dtInt;
 
         if(oper->type == opPlus){
-          token.symbol->data.intVal = leftOperandCopy.symbol->data.intVal + rightOperandCopy.symbol->data.intVal; // adds two integers
+          resData.intVal = leftOperandCopy.symbol->data.intVal + rightOperandCopy.symbol->data.intVal; // adds two integers
         }else if(oper->type == opMns){
-          token.symbol->data.intVal = leftOperandCopy.symbol->data.intVal - rightOperandCopy.symbol->data.intVal; // subs two integers
+          resData.intVal = leftOperandCopy.symbol->data.intVal - rightOperandCopy.symbol->data.intVal; // subs two integers
         }else if(oper->type == opMul){
-          token.symbol->data.intVal = leftOperandCopy.symbol->data.intVal * rightOperandCopy.symbol->data.intVal; // muls two integers
+          resData.intVal = leftOperandCopy.symbol->data.intVal * rightOperandCopy.symbol->data.intVal; // muls two integers
         }else if(oper->type == opDivFlt){
           syntx_intToDoubleToken(&leftOperandCopy);
           syntx_intToDoubleToken(&rightOperandCopy);
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal / rightOperandCopy.symbol->data.doubleVal; // float divides two doubles
-          token.symbol->dataType = dtFloat; // result/dataType after divide is DOUBLE
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal / rightOperandCopy.symbol->data.doubleVal; // float divides two doubles
+          resType = dtFloat; // result/dataType after divide is DOUBLE
         }else if(oper->type == opDiv){
-          token.symbol->data.intVal = leftOperandCopy.symbol->data.intVal / rightOperandCopy.symbol->data.intVal; // integer divides two integers
+          resData.intVal = leftOperandCopy.symbol->data.intVal / rightOperandCopy.symbol->data.intVal; // integer divides two integers
         }
 
       }else if(leftOperandCopy.symbol->dataType == dtFloat && rightOperandCopy.symbol->dataType == dtFloat){  // double - double
@@ -443,22 +503,22 @@ SToken syntx_doArithmeticOp(SToken *leftOperand, SToken *oper, SToken *rightOper
             scan_raiseCodeError(anotherSemanticErr, "Dividing by zero integer.", NULL);  // prints error
           }
 
-          token.symbol->data.intVal = leftOperandCopy.symbol->data.intVal / rightOperandCopy.symbol->data.intVal; // integer divides two doubles
-          token.symbol->dataType = dtInt;
-          return token;
+          resData.intVal = leftOperandCopy.symbol->data.intVal / rightOperandCopy.symbol->data.intVal; // integer divides two doubles
+          resType = dtInt;
+          return syntx_constToken(resType, resData);
         }
 
         if(oper->type == opPlus){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal + rightOperandCopy.symbol->data.doubleVal; // adds two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal + rightOperandCopy.symbol->data.doubleVal; // adds two doubles
         }else if(oper->type == opMns){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal - rightOperandCopy.symbol->data.doubleVal; // subs two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal - rightOperandCopy.symbol->data.doubleVal; // subs two doubles
         }else if(oper->type == opMul){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal * rightOperandCopy.symbol->data.doubleVal; // muls two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal * rightOperandCopy.symbol->data.doubleVal; // muls two doubles
         }else if(oper->type == opDivFlt){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal / rightOperandCopy.symbol->data.doubleVal; // float divides two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal / rightOperandCopy.symbol->data.doubleVal; // float divides two doubles
         }
 
-        token.symbol->dataType = dtFloat;
+        resType = dtFloat;
 
       }else if(leftOperandCopy.symbol->dataType == dtFloat && rightOperandCopy.symbol->dataType == dtInt){  // double - int
 
@@ -471,24 +531,24 @@ SToken syntx_doArithmeticOp(SToken *leftOperand, SToken *oper, SToken *rightOper
             scan_raiseCodeError(anotherSemanticErr, "Dividing by zero integer.", NULL);  // prints error
           }
 
-          token.symbol->data.intVal = leftOperandCopy.symbol->data.intVal / rightOperandCopy.symbol->data.intVal; // integer divides two doubles
-          token.symbol->dataType = dtInt;
-          return token;
+          resData.intVal = leftOperandCopy.symbol->data.intVal / rightOperandCopy.symbol->data.intVal; // integer divides two doubles
+          resType = dtInt;
+          return syntx_constToken(resType, resData);
         }
 
         syntx_intToDoubleToken(&rightOperandCopy); // -> double - double
 
         if(oper->type == opPlus){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal + rightOperandCopy.symbol->data.doubleVal; // adds two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal + rightOperandCopy.symbol->data.doubleVal; // adds two doubles
         }else if(oper->type == opMns){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal - rightOperandCopy.symbol->data.doubleVal; // subs two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal - rightOperandCopy.symbol->data.doubleVal; // subs two doubles
         }else if(oper->type == opMul){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal * rightOperandCopy.symbol->data.doubleVal; // muls two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal * rightOperandCopy.symbol->data.doubleVal; // muls two doubles
         }else if(oper->type == opDivFlt){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal / rightOperandCopy.symbol->data.doubleVal; // float divides two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal / rightOperandCopy.symbol->data.doubleVal; // float divides two doubles
         }
 
-        token.symbol->dataType = dtFloat;
+        resType = dtFloat;
 
       }else if(leftOperandCopy.symbol->dataType == dtInt && rightOperandCopy.symbol->dataType == dtFloat){  // int - double -> double - double
 
@@ -503,45 +563,45 @@ SToken syntx_doArithmeticOp(SToken *leftOperand, SToken *oper, SToken *rightOper
             scan_raiseCodeError(anotherSemanticErr, "Dividing by zero integer.", NULL);  // prints error
           }
 
-          token.symbol->data.intVal = leftOperandCopy.symbol->data.intVal / rightOperandCopy.symbol->data.intVal; // integer divides two doubles
-          token.symbol->dataType = dtInt;
-          return token;
+          resData.intVal = leftOperandCopy.symbol->data.intVal / rightOperandCopy.symbol->data.intVal; // integer divides two doubles
+          resType = dtInt;
+          return syntx_constToken(resType, resData);
         }
 
         syntx_intToDoubleToken(&leftOperandCopy); // -> double - double
 
         if(oper->type == opPlus){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal + rightOperandCopy.symbol->data.doubleVal; // adds two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal + rightOperandCopy.symbol->data.doubleVal; // adds two doubles
         }else if(oper->type == opMns){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal - rightOperandCopy.symbol->data.doubleVal; // subs two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal - rightOperandCopy.symbol->data.doubleVal; // subs two doubles
         }else if(oper->type == opMul){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal * rightOperandCopy.symbol->data.doubleVal; // muls two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal * rightOperandCopy.symbol->data.doubleVal; // muls two doubles
         }else if(oper->type == opDivFlt){
-          token.symbol->data.doubleVal = leftOperandCopy.symbol->data.doubleVal / rightOperandCopy.symbol->data.doubleVal; // float divides two doubles
+          resData.doubleVal = leftOperandCopy.symbol->data.doubleVal / rightOperandCopy.symbol->data.doubleVal; // float divides two doubles
         }
 
-        token.symbol->dataType = dtFloat;
+        resType = dtFloat;
 
       }else if(leftOperandCopy.symbol->dataType == dtString && rightOperandCopy.symbol->dataType == dtString){  // string - string
 
         if(oper->type == opPlus){
-          token.symbol->data.stringVal = util_StrConcatenate(leftOperandCopy.symbol->data.stringVal, rightOperandCopy.symbol->data.stringVal);
-          token.symbol->dataType = dtString;
+          resData.stringVal = util_StrConcatenate(leftOperandCopy.symbol->data.stringVal, rightOperandCopy.symbol->data.stringVal);
+          resType = dtString;
         }
 
       }else if(leftOperand->symbol->dataType == dtBool && rightOperand->symbol->dataType == dtBool){  // bool - bool
         if(oper->type == opEq){
-          token.symbol->data.boolVal = leftOperand->symbol->data.boolVal == rightOperand->symbol->data.boolVal; // bool = bool
-          token.symbol->dataType = dtBool;
+          resData.boolVal = leftOperand->symbol->data.boolVal == rightOperand->symbol->data.boolVal; // bool = bool
+          resType = dtBool;
         }else if(oper->type == opNotEq){
-          token.symbol->data.boolVal = leftOperand->symbol->data.boolVal != rightOperand->symbol->data.boolVal; // bool <> bool
-          token.symbol->dataType = dtBool;
+          resData.boolVal = leftOperand->symbol->data.boolVal != rightOperand->symbol->data.boolVal; // bool <> bool
+          resType = dtBool;
         }else if(oper->type == opBoolAnd){
-          token.symbol->data.boolVal = leftOperand->symbol->data.boolVal && rightOperand->symbol->data.boolVal; // bool AND bool
-          token.symbol->dataType = dtBool;
+          resData.boolVal = leftOperand->symbol->data.boolVal && rightOperand->symbol->data.boolVal; // bool AND bool
+          resType = dtBool;
         }else if(oper->type == opBoolOr){
-          token.symbol->data.boolVal = leftOperand->symbol->data.boolVal || rightOperand->symbol->data.boolVal; // bool OR bool
-          token.symbol->dataType = dtBool;
+          resData.boolVal = leftOperand->symbol->data.boolVal || rightOperand->symbol->data.boolVal; // bool OR bool
+          resType = dtBool;
         }
       }
     }
@@ -551,18 +611,23 @@ SToken syntx_doArithmeticOp(SToken *leftOperand, SToken *oper, SToken *rightOper
     if(leftOperand->symbol->type == symtConstant){  // NOT bool
       if(leftOperand->symbol->dataType == dtBool){
         if(oper->type == opBoolNot){
-          token.symbol->data.boolVal = !leftOperand->symbol->data.boolVal;
-          token.symbol->dataType = dtBool;
+          resData.boolVal = !leftOperand->symbol->data.boolVal;
+          resType = dtBool;
         }
       }
     }
   }// end of rightOperand == NULL
 
   // function was invoked with wrong arguments - typeCompatibilityErr
-  if(token.symbol->dataType == dtUnspecified){
+  if(resType == dtUnspecified){
     scan_raiseCodeError(typeCompatibilityErr, "Error during arithmetic operation with two constants.", NULL);  // prints error
   }
 
+  SToken token = syntx_constToken(resType, resData);
+  if(resType == dtString){  // concatenated string is copied into pool
+    mmng_safeFree(resData.stringVal);
+  }
+
   return token;
 }
 
@@ -571,13 +636,13 @@ SToken syntx_doArithmeticOp(SToken *leftOperand, SToken *oper, SToken *rightOper
  * data type must be int or double, otherwise error
  */
 SToken syntx_doUnaryMinus(SToken *token){
-  SToken resToken = syntx_deepCopyToken(token);
+  SToken resToken = *token;
 
   if(resToken.symbol->dataType == dtInt){
-    resToken.symbol->data.intVal = -resToken.symbol->data.intVal;
+    resToken.symbol = cpool_int(-token->symbol->data.intVal);
     return resToken;
   }else if(resToken.symbol->dataType == dtFloat){
-    resToken.symbol->data.doubleVal = -resToken.symbol->data.doubleVal;
+    resToken.symbol = cpool_double(-token->symbol->data.doubleVal);
     return resToken;
   }
   
@@ -832,7 +897,7 @@ void syntx_generateCodeForRelOps(SToken *leftOperand, SToken *operator, SToken *
   * argIndex represents argument number from beginning
   * argValue represents constant or variable transmitted to the function
   */
- void syntx_generateCodeForVarDef(SToken *funcToken, int argIndex, SToken *argValue){
+ void syntx_checkArgument(SToken *funcToken, int argIndex, SToken *argValue){
 
   TArgList args = funcToken->symbol->data.funcData.arguments;
 
@@ -847,6 +912,14 @@ void syntx_generateCodeForRelOps(SToken *leftOperand, SToken *operator, SToken *
    }else if(args->get(args, argIndex)->dataType != argValue->symbol->dataType){
      scan_raiseCodeError(typeCompatibilityErr, "Argument passed to function has wrong data type.", argValue);  // prints error
    }
+ }
+
+ /**
+  * Generates code for passing of argument to function (pushes it to data stack)
+  */
+ void syntx_generateCodeForVarDef(SToken *funcToken, int argIndex, SToken *argValue){
+
+   syntx_checkArgument(funcToken, argIndex, argValue);
 
    printInstruction("PUSHS ");
    syntx_generateIdent(argValue);
@@ -886,6 +959,106 @@ void syntx_generateCodeForRelOps(SToken *leftOperand, SToken *operator, SToken *
   result->symbol->dataType = funcToken->symbol->data.funcData.returnType;
  }
 
+ /**
+  * True if call of function is replaced by inline code (build-in length, asc and chr)
+  */
+ bool syntx_isInlineFunc(SToken *funcToken){
+  const char *label = funcToken->symbol->data.funcData.label;
+  return strcmp(label, "$$Length") == 0 || strcmp(label, "$$Asc") == 0 || strcmp(label, "$$Chr") == 0;
+ }
+
+ /**
+  * Generates inline code of build-in function instead of its call, constant arguments are evaluated in compile time
+  *
+  * funcToken represents function token
+  * argCount is count of already checked arguments in args
+  * returns token with constant or auxiliary variable with result
+  */
+ SToken syntx_generateCodeForInlineFunc(SToken *funcToken, int argCount, SToken *args){
+  TArgList argList = funcToken->symbol->data.funcData.arguments;
+  if(argList->count > argCount){  // too few arguments
+    scan_raiseCodeError(typeCompatibilityErr, "Too few arguments passed to function.", NULL);
+  }
+  const char *label = funcToken->symbol->data.funcData.label;
+  bool isConst = true;
+  for(int i = 0; i < argCount; i++){
+    if(args[i].symbol->type != symtConstant){
+      isConst = false;
+    }
+  }
+
+  if(strcmp(label, "$$Length") == 0){ // Length(s) -> STRLEN
+    if(isConst){
+      int len = 0;
+      const char *str = args[0].symbol->data.stringVal;
+      while(*str != '\0'){
+        syntx_readStrChar(&str);
+        len++;
+      }
+      return syntx_constToken(dtInt, (Data){ .intVal = len });
+    }
+    SToken result = sytx_getFreeVar();
+    printInstruction("STRLEN %s ", result.symbol->ident);
+    syntx_generateIdent(&args[0]);
+    printInstruction("\n");
+    result.symbol->dataType = dtInt;
+    return result;
+  }
+
+  if(strcmp(label, "$$Chr") == 0){ // Chr(i) -> INT2CHAR, constant out of range is left for runtime error
+    int code = args[0].symbol->data.intVal;
+    if(isConst && code >= 0 && code <= 255){
+      char str[5];
+      sprintf(str, "\\%03d", code);
+      return syntx_constToken(dtString, (Data){ .stringVal = str });
+    }
+    SToken result = sytx_getFreeVar();
+    printInstruction("INT2CHAR %s ", result.symbol->ident);
+    syntx_generateIdent(&args[0]);
+    printInstruction("\n");
+    result.symbol->dataType = dtString;
+    return result;
+  }
+
+  // Asc(s, i) -> ASCII value of i-th char, 0 if i is out of string
+  if(isConst){
+    int index = args[1].symbol->data.intVal;
+    int value = 0;
+    const char *str = args[0].symbol->data.stringVal;
+    for(int i = 1; *str != '\0' && i <= index; i++){
+      unsigned char actChar = syntx_readStrChar(&str);
+      if(i == index){
+        value = actChar;
+      }
+    }
+    return syntx_constToken(dtInt, (Data){ .intVal = value });
+  }
+  SToken result = sytx_getFreeVar();
+  SToken index = sytx_getFreeVar();
+  SToken cond = sytx_getFreeVar();
+  char *endLabel = symbt_getNewLocalLabel();
+  printInstruction("SUB %s ", index.symbol->ident);
+  syntx_generateIdent(&args[1]);
+  printInstruction(" int@1\n");
+  printInstruction("STRLEN %s ", result.symbol->ident);
+  syntx_generateIdent(&args[0]);
+  printInstruction("\n");
+  printInstruction("GT %s %s %s\n", cond.symbol->ident, result.symbol->ident, index.symbol->ident);
+  printInstruction("MOVE %s int@0\n", result.symbol->ident);
+  printInstruction("JUMPIFNEQ %s$asc %s bool@true\n", endLabel, cond.symbol->ident);
+  printInstruction("LT %s %s int@0\n", cond.symbol->ident, index.symbol->ident);
+  printInstruction("JUMPIFEQ %s$asc %s bool@true\n", endLabel, cond.symbol->ident);
+  printInstruction("STRI2INT %s ", result.symbol->ident);
+  syntx_generateIdent(&args[0]);
+  printInstruction(" %s\n", index.symbol->ident);
+  printInstruction("LABEL %s$asc\n", endLabel);
+  mmng_safeFree(endLabel);
+  syntx_freeVar(&index);
+  syntx_freeVar(&cond);
+  result.symbol->dataType = dtInt;
+  return result;
+ }
+
 /**
  * Main function for code generation
  * leftOperand expects constant or ident
@@ -899,14 +1072,14 @@ void syntx_generateCode(SToken *leftOperand, SToken *oper, SToken *rightOperand,
   SToken rightOperandCopy;
 
   if(rightOperand != NULL){
-    rightOperandCopy = syntx_deepCopyToken(rightOperand);
+    rightOperandCopy = *rightOperand;
     rightCopiedTokenAddr = &rightOperandCopy;
   }
 
   if (partialResult == NULL)
     partialResult = leftOperand;
 
-  SToken leftOperandCopy = syntx_deepCopyToken(leftOperand);
+  SToken leftOperandCopy = *leftOperand;
 
   // checks data types, implicitly converts constants and generates code for implicit convertion of variables
   if(rightCopiedTokenAddr != NULL && oper->type != opBoolNot){  // operator is not bool NOT
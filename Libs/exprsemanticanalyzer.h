@@ -24,10 +24,16 @@ SToken syntx_doBoolOp(SToken *leftOperand, SToken *oper, SToken *rightOperand);
 
 SToken syntx_doArithmeticOp(SToken *leftOperand, SToken *oper, SToken *rightOperand);
 
+void syntx_checkArgument(SToken *funcToken, int argIndex, SToken *argValue);
+
 void syntx_generateCodeForVarDef(SToken *funcToken, int argIndex, SToken *argValue);
 
 void syntx_generateCodeForCallFunc(SToken *funcToken, int argIndex, SToken *result);
 
+bool syntx_isInlineFunc(SToken *funcToken);
+
+SToken syntx_generateCodeForInlineFunc(SToken *funcToken, int argCount, SToken *args);
+
 void syntx_generateCode(SToken *leftOperand, SToken *oper, SToken *rightOperand, SToken *partialResult);
 
 void syntx_checkDataTypes(SToken *leftOperand, SToken *operator, SToken *rightOperand);
@@ -0,0 +1,255 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    ifjc.c
+ * \brief   Compiler library and compiler context
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+#include "ifjc.h"
+#include "compilerctx.h"
+#include "mmng.h"
+#include "symtable.h"
+#include "constpool.h"
+#include "rparser.h"
+#include "scanner.h"
+#include "syntaxanalyzer.h"
+#include "incremental.h"
+#include "parallel.h"
+
+#define IFJC_MAX_MESSAGE 1024
+
+// hash of sources of compiler library, every change of compiler changes fingerprint of generated code
+#ifndef IFJC_SOURCE_HASH
+  #define IFJC_SOURCE_HASH "unknown"
+#endif
+
+// kind of build, code of debug build is kept apart from code of release build
+#ifdef DEBUG
+  #define IFJC_BUILD "debug"
+#else
+  #define IFJC_BUILD "release"
+#endif
+
+// actual compiler context of thread
+__thread TCompilerCtx GLBCompilerCtx;
+
+// =============================================================================
+// ====================== Context implementation ===============================
+// =============================================================================
+
+int ctx_getChar()
+{
+  if (GLBCompilerCtx->src == NULL)
+    return getchar();
+  if (GLBCompilerCtx->srcPos >= GLBCompilerCtx->srcLen)
+    return EOF;
+  return (unsigned char)GLBCompilerCtx->src[GLBCompilerCtx->srcPos++];
+}
+
+void ctx_output(const char *data, unsigned len)
+{
+  if (GLBCompilerCtx->output == NULL)
+    fwrite(data, sizeof(char), len, stdout);
+  else
+    GLBCompilerCtx->output(data, len, GLBCompilerCtx->outputData);
+}
+
+void ctx_printError(const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  if (GLBCompilerCtx == NULL || GLBCompilerCtx->diagnostics == NULL)
+    vfprintf(stderr, format, args);
+  else
+  {
+    char message[IFJC_MAX_MESSAGE];
+    int len = vsnprintf(message, IFJC_MAX_MESSAGE, format, args);
+    if (len > 0)
+      GLBCompilerCtx->diagnostics(message, (len < IFJC_MAX_MESSAGE) ? (unsigned)len : IFJC_MAX_MESSAGE - 1,
+        GLBCompilerCtx->diagnosticsData);
+  }
+  va_end(args);
+}
+
+void ctx_raiseError(int code)
+{
+  if (GLBCompilerCtx != NULL && GLBCompilerCtx->errJump != NULL)
+  {
+    GLBCompilerCtx->errCode = code;
+    longjmp(*GLBCompilerCtx->errJump, 1);
+  }
+  exit(code);
+}
+
+// whole program is compiled
+void ifjc_processProgram(void *arg)
+{
+  (void)arg;
+  rparser_processProgram();
+}
+
+int ctx_run(TCompilerCtx ctx, const char *src, unsigned len, TIfjcOutput output, void *userData,
+  void (*process)(void *arg), void *arg)
+{
+  TCompilerCtx prevCtx = GLBCompilerCtx;
+  jmp_buf errJump;
+
+  // every compilation starts with clean state, only settings of context are kept
+  TIfjcOutput diagnostics = ctx->diagnostics;
+  void *diagnosticsData = ctx->diagnosticsData;
+  const char *incrementalPath = ctx->incrementalPath;
+  unsigned jobCnt = ctx->jobCnt;
+  unsigned maxBuffer = ctx->maxBuffer;
+  bool isExitTeardown = ctx->isExitTeardown;
+  struct Parallel *parallel = ctx->parallel;
+  memset(ctx, 0, sizeof(struct CompilerCtx));
+  ctx->diagnostics = diagnostics;
+  ctx->diagnosticsData = diagnosticsData;
+  ctx->incrementalPath = incrementalPath;
+  ctx->jobCnt = jobCnt;
+  ctx->maxBuffer = maxBuffer;
+  ctx->isExitTeardown = isExitTeardown;
+  ctx->parallel = parallel;
+  ctx->src = src;
+  ctx->srcLen = len;
+  ctx->output = output;
+  ctx->outputData = userData;
+  ctx->errJump = &errJump;
+  GLBCompilerCtx = ctx;
+
+  if (setjmp(errJump) == 0)
+  {
+    STATS_BEGIN(initStart);
+    mmng_init();
+    symbt_init("$$main");
+    cpool_init();
+    scan_init();
+    syntx_init();
+    incr_init();
+    STATS_END(statsInit, initStart);
+    STATS_BEGIN(compileStart);
+    process(arg);
+    incr_save();
+    STATS_END(statsCompile, compileStart);
+    STATS_BEGIN(teardownStart);
+    if (ctx->isExitTeardown)
+      mmng_abandonAll(); // process exits after compilation, so it releases memory at once
+    else
+    {
+      // all memory of modules is owned by memory manager and it is released by it in one pass
+      // as on error, modules free their structures one by one only in debug build to check it
+      #ifdef DEBUG
+      incr_destroy();
+      syntx_destroy();
+      scan_destroy();
+      symbt_destroy();
+      cpool_destroy();
+      #endif // DEBUG
+      mmng_freeAll();
+    }
+    STATS_END(statsTeardown, teardownStart);
+  }
+
+  int result = ctx->errCode;
+  ctx->errJump = NULL;
+  GLBCompilerCtx = prevCtx;
+  return result;
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+TCompilerCtx ifjc_createCtx()
+{
+  // context holds memory manager, so it is not allocated by it
+  TCompilerCtx ctx = malloc(sizeof(struct CompilerCtx));
+  if (ctx != NULL)
+    memset(ctx, 0, sizeof(struct CompilerCtx));
+  return ctx;
+}
+
+int ifjc_compile(TCompilerCtx ctx, const char *src, unsigned len, TIfjcOutput output, void *userData)
+{
+  // bodies of functions are generated in parallel when source is in memory, incremental compilation
+  // reuses code of functions, so its changed functions are compiled sequentially
+  if (ctx->jobCnt > 1 && src != NULL && ctx->incrementalPath == NULL)
+  {
+    TParallel parallel = par_create(ctx->jobCnt - 1, ctx->diagnostics, ctx->diagnosticsData);
+    if (parallel != NULL)
+    {
+      // errors are not reported until code of all functions is generated, failed compilation is
+      // repeated sequentially, so errors are reported exactly in order of source code
+      TIfjcOutput diagnostics = ctx->diagnostics;
+      void *diagnosticsData = ctx->diagnosticsData;
+      ctx->diagnostics = par_discard;
+      ctx->diagnosticsData = NULL;
+      ctx->parallel = parallel;
+      int result = ctx_run(ctx, src, len, output, userData, ifjc_processProgram, NULL);
+      ctx->parallel = NULL;
+      ctx->diagnostics = diagnostics;
+      ctx->diagnosticsData = diagnosticsData;
+      if (par_destroy(parallel))
+        return result;
+    }
+  }
+  return ctx_run(ctx, src, len, output, userData, ifjc_processProgram, NULL);
+}
+
+void ifjc_setDiagnostics(TCompilerCtx ctx, TIfjcOutput diagnostics, void *userData)
+{
+  ctx->diagnostics = diagnostics;
+  ctx->diagnosticsData = userData;
+}
+
+void ifjc_setIncremental(TCompilerCtx ctx, const char *path)
+{
+  ctx->incrementalPath = path;
+}
+
+void ifjc_setJobs(TCompilerCtx ctx, unsigned jobCnt)
+{
+  ctx->jobCnt = jobCnt;
+}
+
+void ifjc_setMaxBuffer(TCompilerCtx ctx, unsigned size)
+{
+  ctx->maxBuffer = size;
+}
+
+void ifjc_fingerprint(TCompilerCtx ctx, char *buffer)
+{
+  snprintf(buffer, IFJC_MAX_FINGERPRINT, "%s/%s/%s/max-buffer=%u", IFJC_VERSION, IFJC_SOURCE_HASH, IFJC_BUILD,
+    ctx->maxBuffer);
+}
+
+bool ifjc_printStats(TCompilerCtx ctx, TIfjcOutput output, void *userData)
+{
+  #ifdef STATS
+  stats_printJson(&ctx->stats, ctx->errCode, output, userData);
+  return true;
+  #else
+  (void)ctx;
+  (void)output;
+  (void)userData;
+  return false;
+  #endif // STATS
+}
+
+void ifjc_setExitTeardown(TCompilerCtx ctx, bool isExitTeardown)
+{
+  ctx->isExitTeardown = isExitTeardown;
+}
+
+void ifjc_destroyCtx(TCompilerCtx ctx)
+{
+  free(ctx);
+}
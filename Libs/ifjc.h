@@ -0,0 +1,168 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    ifjc.h
+ * \brief   Interface of compiler library (libifjc)
+ *
+ * Library compiles IFJ17 programs into IFJcode17. Every compilation has its own compiler context,
+ * so more programs can be compiled in one process, one context in one thread at a time.
+ *
+ * Example:
+ *   TCompilerCtx ctx = ifjc_createCtx();
+ *   int result = ifjc_compile(ctx, src, strlen(src), writeCode, file);
+ *   ifjc_destroyCtx(ctx);
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _Ifjc
+#define _Ifjc
+
+#include <stdbool.h>
+
+/**
+ * Version of compiler, fingerprint of generated code contains also hash of sources of compiler,
+ * so cached code of other build is not reused even if version was not changed
+ */
+#define IFJC_VERSION "ifjc 1.7"
+
+/**
+ * Maximal length of fingerprint of generated code (ifjc_fingerprint) including terminating zero
+ */
+#define IFJC_MAX_FINGERPRINT 128
+
+/**
+ * Compiler context, state of one compilation
+ */
+typedef struct CompilerCtx *TCompilerCtx;
+
+/**
+ * Output of generated code
+ *
+ * \param data part of generated code
+ * \param len length of data
+ * \param userData user data given to ifjc_compile
+ */
+typedef void (*TIfjcOutput)(const char *data, unsigned len, void *userData);
+
+/**
+ * Creates compiler context
+ *
+ * \returns new context or NULL if there is not enough memory
+ */
+TCompilerCtx ifjc_createCtx();
+
+/**
+ * Compiles program
+ *
+ * Errors of compilation are reported to diagnostics of context (standard error output by default)
+ * and returned, process is not terminated.
+ * Context can be used for more compilations one after another.
+ *
+ * \param ctx compiler context
+ * \param src source code, NULL to read it from standard input
+ * \param len length of source code
+ * \param output output of generated code, NULL to write it to standard output
+ * \param userData user data passed to output
+ * \returns 0 on success, otherwise error code of compilation (ErrType)
+ */
+int ifjc_compile(TCompilerCtx ctx, const char *src, unsigned len, TIfjcOutput output, void *userData);
+
+/**
+ * Sets output of error messages of compilations
+ *
+ * \param ctx compiler context
+ * \param diagnostics output of error messages, NULL for standard error output
+ * \param userData user data passed to diagnostics
+ */
+void ifjc_setDiagnostics(TCompilerCtx ctx, TIfjcOutput diagnostics, void *userData);
+
+/**
+ * Enables incremental compilation
+ *
+ * Code of functions is kept in file between compilations of context (or processes), code of
+ * functions which were not changed since previous compilation is reused. Incremental compilation
+ * needs source code in memory, it is not used for source read from standard input.
+ *
+ * \param ctx compiler context
+ * \param path path of file with code of functions, NULL disables incremental compilation
+ */
+void ifjc_setIncremental(TCompilerCtx ctx, const char *path);
+
+/**
+ * Sets count of threads generating code of one program
+ *
+ * With more jobs, bodies of functions are compiled in parallel, every one in its own context with
+ * signatures of functions known at its definition, and code is joined in order of source, so it is
+ * the same as code of sequential compilation. It is used only for source code in memory.
+ *
+ * \param ctx compiler context
+ * \param jobCnt count of threads including calling one, 0 or 1 for sequential compilation
+ */
+void ifjc_setJobs(TCompilerCtx ctx, unsigned jobCnt);
+
+/**
+ * Limits size of buffered code of main scope
+ *
+ * Code of main scope is normally generated and optimized as whole. With limit, buffered code is
+ * printed in blocks between statements of main scope whenever it exceeds the limit, so memory of
+ * compilation does not grow with size of main scope. Blocks are optimized separately, functions
+ * which are never called are printed too and calls from main scope are not expanded inline.
+ * When compilation fails, part of code can be already written to output.
+ *
+ * \param ctx compiler context
+ * \param size limit in bytes, 0 for no limit
+ */
+void ifjc_setMaxBuffer(TCompilerCtx ctx, unsigned size);
+
+/**
+ * Leaves memory of successful compilations to exit of process
+ *
+ * Memory of compilation is normally freed at its end. When process exits right after compilation,
+ * freeing is wasted work, so with this setting the whole memory of compilation is left to be
+ * released by the operating system. Memory of failed compilations is still freed. It must not be
+ * used by processes which go on running (server, batch) or which are checked for memory leaks.
+ *
+ * \param ctx compiler context
+ * \param isExitTeardown true to leave memory to exit of process, false to free it (default)
+ */
+void ifjc_setExitTeardown(TCompilerCtx ctx, bool isExitTeardown);
+
+/**
+ * Writes fingerprint of generated code of context
+ *
+ * Fingerprint consists of version of compiler, hash of sources of compiler library (IFJC_SOURCE_HASH,
+ * defined by Makefile), kind of build and all settings of context which change generated code
+ * (limit of buffered code). The same source compiled by contexts with equal fingerprints gives the same
+ * code, so fingerprint with source identifies compiled program (key of cache). Diagnostics, jobs,
+ * incremental compilation and teardown do not change generated code and they are not part of it.
+ *
+ * \param ctx compiler context
+ * \param buffer output of fingerprint terminated by zero, at least IFJC_MAX_FINGERPRINT bytes
+ */
+void ifjc_fingerprint(TCompilerCtx ctx, char *buffer);
+
+/**
+ * Prints counters of last compilation of context as JSON object
+ *
+ * Report contains wall times of phases of compilation and counters of hot paths (symbol lookups,
+ * rotations of symbol tables, allocations, tokens, reductions of expressions, auxiliary variables
+ * and size of code). Counters exist only in compiler built with STATS defined (make stats).
+ *
+ * \param ctx compiler context
+ * \param output output of report
+ * \param userData user data passed to output
+ * \returns false if compiler is built without counters, nothing is printed then
+ */
+bool ifjc_printStats(TCompilerCtx ctx, TIfjcOutput output, void *userData);
+
+/**
+ * Frees compiler context
+ *
+ * \param ctx compiler context
+ */
+void ifjc_destroyCtx(TCompilerCtx ctx);
+
+#endif // _Ifjc
@@ -0,0 +1,270 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    incremental.c
+ * \brief   Incremental compilation of functions
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "incremental.h"
+#include "scanner.h"
+#include "symtable.h"
+#include "mmng.h"
+#include "membuf.h"
+#include "compilerctx.h"
+
+#define INCR_HEADER "IFJC-INCREMENTAL " IFJC_VERSION "\n"
+#define INCR_CHUNK 32
+
+/**
+ * Code of one function
+ */
+typedef struct {
+  uint64_t key[2];  /*!< fingerprint of function */
+  char *code;       /*!< whole code unit of function */
+  unsigned len;     /*!< length of code */
+} TIncrEntry;
+
+/**
+ * State of incremental compilation
+ */
+struct Incremental {
+  TIncrEntry *loaded;   /*!< functions of previous compilation */
+  unsigned loadedCnt;
+  TIncrEntry *stored;   /*!< functions of actual compilation */
+  unsigned storedCnt;
+  unsigned storedCap;
+  uint64_t actKey[2];   /*!< fingerprint of last probed function */
+  bool hasActKey;       /*!< false if last function could not be probed */
+};
+
+/**
+ * Fingerprint computed while function is read ahead
+ */
+typedef struct {
+  uint64_t hash[2];
+  EGrSymb prevType;     /*!< type of previous token */
+} TIncrProbe;
+
+// state of incremental compilation is part of actual compiler context
+#define GLBIncremental (GLBCompilerCtx->incremental)
+
+// =============================================================================
+// ====================== support functions ====================================
+// =============================================================================
+
+// FNV-1a hash of memory block continuing from both hash values
+void incr_hashBytes(uint64_t hash[2], const void *bytes, size_t len)
+{
+  const unsigned char *actByte = bytes;
+  for (size_t i = 0; i < len; i++)
+  {
+    hash[0] = (hash[0] ^ actByte[i]) * 1099511628211ull;
+    hash[1] = (hash[1] ^ actByte[i]) * 1099511628211ull + 0x9e3779b97f4a7c15ull;
+  }
+}
+
+void incr_hashString(uint64_t hash[2], const char *str)
+{
+  incr_hashBytes(hash, str, (str != NULL) ? strlen(str) + 1 : 0);
+}
+
+void incr_hashInt(uint64_t hash[2], int value)
+{
+  incr_hashBytes(hash, &value, sizeof(value));
+}
+
+/**
+ * Adds token to fingerprint, identifier of global symbol adds also its signature
+ * Stops reading ahead after "end function".
+ */
+bool incr_visitToken(SToken *token, void *userData)
+{
+  TIncrProbe *probe = userData;
+  incr_hashInt(probe->hash, token->type);
+  incr_hashInt(probe->hash, token->dataType);
+  TSymbol symbol = token->symbol;
+  if (symbol != NULL)
+  {
+    incr_hashInt(probe->hash, symbol->type);
+    incr_hashInt(probe->hash, symbol->dataType);
+    if (symbol->type == symtConstant)
+    {
+      switch (symbol->dataType)
+      {
+        case dtInt: incr_hashInt(probe->hash, symbol->data.intVal); break;
+        case dtFloat: incr_hashBytes(probe->hash, &symbol->data.doubleVal, sizeof(double)); break;
+        case dtString: incr_hashString(probe->hash, symbol->data.stringVal); break;
+        default: incr_hashInt(probe->hash, symbol->data.boolVal); break;
+      }
+    }
+    else
+    {
+      // identifiers unknown before function are local, others are visible from outside
+      incr_hashString(probe->hash, symbol->key);
+      incr_hashString(probe->hash, symbol->ident);
+    }
+    if (symbol->type == symtFuction)
+    {
+      incr_hashString(probe->hash, symbol->data.funcData.label);
+      incr_hashInt(probe->hash, symbol->data.funcData.returnType);
+      TArgList arguments = symbol->data.funcData.arguments;
+      incr_hashInt(probe->hash, (arguments != NULL) ? arguments->count : -1);
+      for (TArgument arg = (arguments != NULL) ? arguments->head : NULL; arg != NULL; arg = arg->next)
+      {
+        incr_hashString(probe->hash, arg->ident);
+        incr_hashInt(probe->hash, arg->dataType);
+      }
+    }
+  }
+  bool isEnd = probe->prevType == kwEnd && token->type == kwFunction;
+  probe->prevType = token->type;
+  return !isEnd;
+}
+
+// finds function of previous compilation by fingerprint
+TIncrEntry *incr_find(uint64_t key[2])
+{
+  for (unsigned i = 0; i < GLBIncremental->loadedCnt; i++)
+    if (GLBIncremental->loaded[i].key[0] == key[0] && GLBIncremental->loaded[i].key[1] == key[1])
+      return &GLBIncremental->loaded[i];
+  return NULL;
+}
+
+/**
+ * Loads functions of previous compilation
+ * File: header, then for every function line "<fingerprint> <length of code>" followed by code.
+ * Invalid or missing file means that there are no functions.
+ */
+void incr_load(const char *path)
+{
+  FILE *file = fopen(path, "rb");
+  if (file == NULL)
+    return;
+  char header[sizeof(INCR_HEADER)];
+  if (fgets(header, sizeof(header), file) == NULL || strcmp(header, INCR_HEADER) != 0)
+  {
+    fclose(file);
+    return; // file of other version of compiler
+  }
+  unsigned cap = 0;
+  unsigned long long key0;
+  unsigned long long key1;
+  unsigned len;
+  while (fscanf(file, "%16llx%16llx %u", &key0, &key1, &len) == 3 && fgetc(file) == '\n')
+  {
+    char *code = mmng_safeMalloc(sizeof(char) * (len + 1));
+    if (fread(code, sizeof(char), len, file) != len)
+    {
+      mmng_safeFree(code);
+      break;
+    }
+    code[len] = '\0';
+    if (GLBIncremental->loadedCnt == cap)
+    {
+      cap += INCR_CHUNK;
+      GLBIncremental->loaded = mmng_safeRealloc(GLBIncremental->loaded, sizeof(TIncrEntry) * cap);
+    }
+    TIncrEntry *entry = &GLBIncremental->loaded[GLBIncremental->loadedCnt++];
+    entry->key[0] = key0;
+    entry->key[1] = key1;
+    entry->code = code;
+    entry->len = len;
+  }
+  fclose(file);
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+void incr_init()
+{
+  if (GLBCompilerCtx->incrementalPath == NULL)
+    return;
+  GLBIncremental = mmng_safeMalloc(sizeof(struct Incremental));
+  memset(GLBIncremental, 0, sizeof(struct Incremental));
+  incr_load(GLBCompilerCtx->incrementalPath);
+}
+
+const char *incr_probeFunction(unsigned *len)
+{
+  if (GLBIncremental == NULL)
+    return NULL;
+  TIncrProbe probe;
+  probe.hash[0] = 14695981039346656037ull;
+  probe.hash[1] = 0x6a09e667f3bcc908ull;
+  probe.prevType = eol;
+  incr_hashString(probe.hash, INCR_HEADER);
+  GLBIncremental->hasActKey = scan_lookAhead(incr_visitToken, &probe);
+  if (!GLBIncremental->hasActKey)
+    return NULL; // function is not complete, errors are reported by analysis
+
+  GLBIncremental->actKey[0] = probe.hash[0];
+  GLBIncremental->actKey[1] = probe.hash[1];
+  TIncrEntry *entry = incr_find(probe.hash);
+  if (entry == NULL)
+    return NULL;
+  *len = entry->len;
+  return entry->code;
+}
+
+void incr_storeFunction(const char *code, unsigned len)
+{
+  if (GLBIncremental == NULL || !GLBIncremental->hasActKey)
+    return;
+  if (GLBIncremental->storedCnt == GLBIncremental->storedCap)
+  {
+    GLBIncremental->storedCap += INCR_CHUNK;
+    GLBIncremental->stored = mmng_safeRealloc(GLBIncremental->stored, sizeof(TIncrEntry) * GLBIncremental->storedCap);
+  }
+  TIncrEntry *entry = &GLBIncremental->stored[GLBIncremental->storedCnt++];
+  entry->key[0] = GLBIncremental->actKey[0];
+  entry->key[1] = GLBIncremental->actKey[1];
+  entry->code = mmng_safeMalloc(sizeof(char) * (len + 1));
+  memcpy(entry->code, code, len);
+  entry->code[len] = '\0';
+  entry->len = len;
+  GLBIncremental->hasActKey = false;
+}
+
+void incr_save()
+{
+  if (GLBIncremental == NULL)
+    return;
+  TMemBuf out = { NULL, 0, 0 };
+  mbuf_append(&out, INCR_HEADER, strlen(INCR_HEADER));
+  for (unsigned i = 0; i < GLBIncremental->storedCnt; i++)
+  {
+    TIncrEntry *entry = &GLBIncremental->stored[i];
+    char line[64];
+    int lineLen = sprintf(line, "%016llx%016llx %u\n",
+      (unsigned long long)entry->key[0], (unsigned long long)entry->key[1], entry->len);
+    mbuf_append(&out, line, lineLen);
+    mbuf_append(&out, entry->code, entry->len);
+  }
+  if (!mbuf_writeFile(&out, GLBCompilerCtx->incrementalPath))
+    ctx_printError("%s: file of incremental compilation cannot be written\n", GLBCompilerCtx->incrementalPath);
+  mbuf_free(&out);
+}
+
+void incr_destroy()
+{
+  if (GLBIncremental == NULL)
+    return;
+  for (unsigned i = 0; i < GLBIncremental->loadedCnt; i++)
+    mmng_safeFree(GLBIncremental->loaded[i].code);
+  for (unsigned i = 0; i < GLBIncremental->storedCnt; i++)
+    mmng_safeFree(GLBIncremental->stored[i].code);
+  if (GLBIncremental->loaded != NULL)
+    mmng_safeFree(GLBIncremental->loaded);
+  if (GLBIncremental->stored != NULL)
+    mmng_safeFree(GLBIncremental->stored);
+  mmng_safeFree(GLBIncremental);
+  GLBIncremental = NULL;
+}
@@ -0,0 +1,59 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    incremental.h
+ * \brief   Incremental compilation of functions
+ *
+ * Generated code of every function (its whole code unit before inline expansion) is kept in file
+ * between compilations. Before function is analyzed, its tokens are read ahead up to "end function"
+ * and fingerprint of function is computed from them and from signatures of global symbols used by
+ * them (functions called by it, its own declaration). Code of function with known fingerprint is
+ * reused and body of function is only skipped, other functions are analyzed and generated normally.
+ *
+ * Code of function never depends on code of other functions (labels and variables of function are
+ * prefixed by its label), so reused code can be mixed with new one. After successful compilation
+ * file is replaced by code of functions of this compilation.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _Incremental
+#define _Incremental
+
+/**
+ * Initializes incremental compilation, code of functions is loaded from file of actual context
+ * (ifjc_setIncremental()), without file incremental compilation is disabled
+ */
+void incr_init();
+
+/**
+ * Computes fingerprint of function and finds code of it from previous compilation
+ *
+ * Has to be called when actual token is keyword "function" of definition of function.
+ *
+ * \param len returns length of code
+ * \returns code of unchanged function or NULL if function has to be compiled
+ */
+const char *incr_probeFunction(unsigned *len);
+
+/**
+ * Remembers code of last probed function for next compilation
+ *
+ * \param code whole code unit of function
+ * \param len length of code
+ */
+void incr_storeFunction(const char *code, unsigned len);
+
+/**
+ * Writes code of all functions of compilation to file, it is called when compilation succeeds
+ */
+void incr_save();
+
+/**
+ * Frees data of incremental compilation
+ */
+void incr_destroy();
+
+#endif // _Incremental
@@ -0,0 +1,286 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    inliner.c
+ * \brief   Inline expansion of small functions
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "inliner.h"
+#include "codebuf.h"
+#include "mmng.h"
+#include "compilerctx.h"
+
+#define INL_CHUNK 64
+
+// counter of expanded call sites, labels of every inlined body get unique suffix, it is part of actual compiler context
+#define inlSiteCnt (GLBCompilerCtx->inlSiteCnt)
+
+// =============================================================================
+// ====================== support functions ====================================
+// =============================================================================
+
+// true if line is exactly str
+bool inl_isLine(TCodeLine line, const char *str)
+{
+  return line.len == strlen(str) && strncmp(line.text, str, line.len) == 0;
+}
+
+// true if line begins with prefix
+bool inl_startsWith(TCodeLine line, const char *prefix)
+{
+  unsigned len = strlen(prefix);
+  return line.len >= len && strncmp(line.text, prefix, len) == 0;
+}
+
+// appends variable of called function moved to local frame of caller
+void inl_printVar(TCodeBuf *out, const char *prefix, const char *name, unsigned len)
+{
+  cbuf_printStr(out, "LF@");
+  cbuf_printStr(out, prefix);
+  cbuf_print(out, name, len);
+}
+
+// appends definition of variable to definitions if it is not there yet
+void inl_addDef(TCodeBuf *defs, const char *prefix, const char *name, unsigned len)
+{
+  TCodeBuf line = { NULL, 0, 0 };
+  cbuf_printStr(&line, "DEFVAR ");
+  inl_printVar(&line, prefix, name, len);
+  cbuf_printStr(&line, "\n");
+  for (const char *found = (defs->text != NULL) ? strstr(defs->text, line.text) : NULL;
+       found != NULL; found = strstr(found + 1, line.text))
+  {
+    if (found == defs->text || found[-1] == '\n')
+    {
+      mmng_safeFree(line.text);
+      return;
+    }
+  }
+  cbuf_print(defs, line.text, line.len);
+  mmng_safeFree(line.text);
+}
+
+/**
+ * Appends instruction of inlined body
+ * Operands in frames of called function are moved to local frame of caller and labels get suffix of call site.
+ */
+void inl_printBodyInstr(TCodeBuf *out, TCodeLine line, const char *prefix, const char *suffix)
+{
+  bool isLabelInstr = inl_startsWith(line, "LABEL ") || inl_startsWith(line, "JUMP ") ||
+    inl_startsWith(line, "JUMPIFEQ ") || inl_startsWith(line, "JUMPIFNEQ ");
+  TCodeInstr instr;
+  cbuf_parseInstr(line, &instr);
+  for (int operand = 0; operand < instr.opCnt; operand++)
+  {
+    const char *act = instr.ops[operand];
+    unsigned len = instr.opLens[operand];
+    if (operand > 0)
+      cbuf_printStr(out, " ");
+    if (operand == 1 && isLabelInstr)
+    {
+      cbuf_print(out, act, len);
+      cbuf_printStr(out, suffix);
+    }
+    else if (operand > 0 && len > 3 && (strncmp(act, "LF@", 3) == 0 || strncmp(act, "TF@", 3) == 0))
+      inl_printVar(out, prefix, act + 3, len - 3);
+    else
+      cbuf_print(out, act, len);
+  }
+  cbuf_printStr(out, "\n");
+}
+
+/**
+ * Checks if function can be inlined
+ * Code of function has to start by LABEL and PUSHFRAME, every POPFRAME has to be followed by RETURN
+ * and body cannot contain any call and has to fit into INLINE_BUDGET instructions. Calls inside of
+ * body are not allowed because their PUSHFRAME needs temporary frame, which would be frame of caller
+ * after inlining. Functions are expanded bottom-up, so calls of small functions in body are already
+ * expanded at this point and recursive functions are never inlined.
+ */
+bool inl_isInlinable(TCodeLine *lines, int lineCnt, const char *label, unsigned labelLen)
+{
+  if (lineCnt < 4 || !inl_startsWith(lines[0], "LABEL ") || lines[0].len != labelLen + 6 ||
+      strncmp(lines[0].text + 6, label, labelLen) != 0 || !inl_isLine(lines[1], "PUSHFRAME"))
+    return false;
+
+  int instrCnt = 0;
+  for (int i = 2; i < lineCnt; i++)
+  {
+    TCodeLine line = lines[i];
+    if (inl_isLine(line, "POPFRAME") && i + 1 < lineCnt && inl_isLine(lines[i + 1], "RETURN"))
+      i++; // end of function
+    else if (inl_startsWith(line, "RETURN") || inl_startsWith(line, "POPFRAME") || inl_startsWith(line, "CALL ") ||
+             inl_isLine(line, "PUSHFRAME"))
+      return false;
+    if (!inl_startsWith(line, "LABEL ") && !inl_startsWith(line, "DEFVAR "))
+      instrCnt++;
+  }
+  return instrCnt <= INLINE_BUDGET;
+}
+
+/**
+ * Appends body of called function instead of call sequence
+ * \returns false if function cannot be inlined
+ */
+bool inl_expandCall(TCodeBuf *out, TCodeBuf *defs, const char *code, const char *label, unsigned labelLen,
+                    TCodeLine *params, int paramCnt, TCodeLine dest)
+{
+  TCodeLine *lines = NULL;
+  int lineCnt = cbuf_splitLines(code, &lines);
+  if (!inl_isInlinable(lines, lineCnt, label, labelLen))
+  {
+    if (lines != NULL)
+      mmng_safeFree(lines);
+    return false;
+  }
+
+  // variables of called function "$f" are "LF@%f$name" in caller
+  char *prefix = mmng_safeMalloc(sizeof(char) * (labelLen + 3));
+  const char *name = (label[0] == '$') ? label + 1 : label;
+  unsigned nameLen = (label[0] == '$') ? labelLen - 1 : labelLen;
+  prefix[0] = '%';
+  memcpy(prefix + 1, name, nameLen);
+  prefix[nameLen + 1] = '$';
+  prefix[nameLen + 2] = '\0';
+  char suffix[16];
+  sprintf(suffix, "$i%u", inlSiteCnt++);
+
+  // parameters are taken from data stack in the same order as in call sequence
+  for (int i = 0; i < paramCnt; i++)
+  {
+    inl_addDef(defs, prefix, params[i].text + 3, params[i].len - 3);
+    cbuf_printStr(out, "POPS ");
+    inl_printVar(out, prefix, params[i].text + 3, params[i].len - 3);
+    cbuf_printStr(out, "\n");
+  }
+
+  // every return jumps to end of inlined body, the last one just continues
+  for (int i = 2; i < lineCnt; i++)
+  {
+    TCodeLine line = lines[i];
+    if (inl_isLine(line, "POPFRAME"))
+    {
+      i++;
+      if (i + 1 < lineCnt)
+      {
+        cbuf_printStr(out, "JUMP ");
+        cbuf_print(out, label, labelLen);
+        cbuf_printStr(out, "$return");
+        cbuf_printStr(out, suffix);
+        cbuf_printStr(out, "\n");
+      }
+    }
+    else if (inl_isLine(line, "CREATEFRAME"))
+      continue; // temporary frame of called function is local frame of caller now
+    else if (inl_startsWith(line, "DEFVAR ") && line.len > 10)
+      inl_addDef(defs, prefix, line.text + 10, line.len - 10);
+    else
+      inl_printBodyInstr(out, line, prefix, suffix);
+  }
+
+  // result of call
+  cbuf_printStr(out, "LABEL ");
+  cbuf_print(out, label, labelLen);
+  cbuf_printStr(out, "$return");
+  cbuf_printStr(out, suffix);
+  cbuf_printStr(out, "\n");
+  cbuf_printStr(out, "MOVE ");
+  cbuf_print(out, dest.text + 5, dest.len - 5);
+  cbuf_printStr(out, " ");
+  inl_printVar(out, prefix, "%retval", 7);
+  cbuf_printStr(out, "\n");
+
+  mmng_safeFree(prefix);
+  mmng_safeFree(lines);
+  return true;
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+// Expands calls of small functions in code of one function
+char *inl_expandCalls(const char *code, TInlGetCode getCode)
+{
+  if (INLINE_BUDGET <= 0)
+    return NULL;
+
+  TCodeLine *lines = NULL;
+  int lineCnt = cbuf_splitLines(code, &lines);
+  TCodeBuf out = { NULL, 0, 0 };
+  TCodeBuf defs = { NULL, 0, 0 };
+  TCodeLine *params = NULL;
+  int paramCap = 0;
+  bool isExpanded = false;
+
+  for (int i = 0; i < lineCnt; i++)
+  {
+    // call sequence: PUSHFRAME, CREATEFRAME, (DEFVAR TF@p, POPS TF@p)*, CALL f, PUSHS TF@%retval, POPFRAME, POPS dest
+    if (inl_isLine(lines[i], "PUSHFRAME") && i + 1 < lineCnt && inl_isLine(lines[i + 1], "CREATEFRAME"))
+    {
+      int j = i + 2;
+      int paramCnt = 0;
+      while (j + 1 < lineCnt && inl_startsWith(lines[j], "DEFVAR TF@") && inl_startsWith(lines[j + 1], "POPS ") &&
+             lines[j].len == lines[j + 1].len + 2 &&
+             strncmp(lines[j].text + 7, lines[j + 1].text + 5, lines[j].len - 7) == 0)
+      {
+        if (paramCnt == paramCap)
+        {
+          paramCap += INL_CHUNK;
+          params = mmng_safeRealloc(params, sizeof(TCodeLine) * paramCap);
+        }
+        params[paramCnt].text = lines[j].text + 7;
+        params[paramCnt].len = lines[j].len - 7;
+        paramCnt++;
+        j += 2;
+      }
+      if (j + 3 < lineCnt && inl_startsWith(lines[j], "CALL ") && inl_isLine(lines[j + 1], "PUSHS TF@%retval") &&
+          inl_isLine(lines[j + 2], "POPFRAME") && inl_startsWith(lines[j + 3], "POPS "))
+      {
+        const char *label = lines[j].text + 5;
+        unsigned labelLen = lines[j].len - 5;
+        const char *calleeCode = getCode(label, labelLen);
+        if (calleeCode != NULL &&
+            inl_expandCall(&out, &defs, calleeCode, label, labelLen, params, paramCnt, lines[j + 3]))
+        {
+          isExpanded = true;
+          i = j + 3;
+          continue;
+        }
+      }
+    }
+    cbuf_print(&out, lines[i].text, lines[i].len);
+    cbuf_printStr(&out, "\n");
+  }
+
+  if (lines != NULL)
+    mmng_safeFree(lines);
+  if (params != NULL)
+    mmng_safeFree(params);
+  if (!isExpanded)
+  {
+    if (out.text != NULL)
+      mmng_safeFree(out.text);
+    if (defs.text != NULL)
+      mmng_safeFree(defs.text);
+    return NULL;
+  }
+
+  // variables of inlined functions are defined once on start of local frame of caller (after its PUSHFRAME)
+  TCodeBuf result = { NULL, 0, 0 };
+  const char *frameStart = strstr(out.text, "\nPUSHFRAME\n");
+  unsigned headLen = (frameStart != NULL) ? (unsigned)(frameStart - out.text) + 11 : 0;
+  cbuf_print(&result, out.text, headLen);
+  if (defs.text != NULL)
+    cbuf_print(&result, defs.text, defs.len);
+  cbuf_print(&result, out.text + headLen, out.len - headLen);
+  mmng_safeFree(out.text);
+  if (defs.text != NULL)
+    mmng_safeFree(defs.text);
+  return result.text;
+}
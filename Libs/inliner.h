@@ -0,0 +1,43 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    inliner.h
+ * \brief   Inline expansion of small functions
+ *
+ * Calls of small non-recursive functions are replaced by body of called function.
+ * Parameters, local variables, %retval and auxiliary variables of called function
+ * become variables of local frame of calling function (prefixed by name of called function),
+ * so frame of call (PUSHFRAME, CREATEFRAME, DEFVAR/POPS of parameters, CALL, RETURN, POPFRAME)
+ * is not needed. Labels of inlined body get unique suffix for every call site.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _Inliner
+#define _Inliner
+
+#include <stdbool.h>
+
+// maximal count of instructions of inlined function, it can be changed by -DINLINE_BUDGET=n (0 disables inlining)
+#ifndef INLINE_BUDGET
+#define INLINE_BUDGET 24
+#endif
+
+/**
+ * Callback returning code of function with label (len characters of label), NULL if code is not known
+ */
+typedef const char *(*TInlGetCode)(const char *label, unsigned len);
+
+/**
+ * Expands calls of small functions in code of one function
+ *
+ * \param code code of calling function starting by its label and PUSHFRAME
+ * \param getCode callback returning code of called function
+ * \returns new code or NULL if no call was expanded
+ * \note Memory is allocated here and free has to be called.
+ */
+char *inl_expandCalls(const char *code, TInlGetCode getCode);
+
+#endif // _Inliner
@@ -0,0 +1,342 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    licm.c
+ * \brief   Loop-invariant code motion
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "licm.h"
+#include "codebuf.h"
+#include "mmng.h"
+#include "compilerctx.h"
+
+#define LICM_CHUNK 64
+
+// counter of auxiliary variables, names are unique inside of function, it is part of actual compiler context
+#define licmVarCnt (GLBCompilerCtx->licmVarCnt)
+
+/**
+ * Temporary variable whose value is held by auxiliary variable
+ */
+typedef struct {
+  const char *temp;  /*!< name of temporary variable */
+  unsigned len;      /*!< length of name */
+  char *var;         /*!< auxiliary variable */
+} TLicmMapping;
+
+/**
+ * Count of assignments of variable in loop
+ */
+typedef struct {
+  const char *name;
+  unsigned len;
+  int cnt;
+} TLicmWrite;
+
+// =============================================================================
+// ====================== support functions ====================================
+// =============================================================================
+
+// splits code into instructions, returns their count
+int licm_parse(const char *code, TCodeInstr **instrs)
+{
+  int cnt = 0;
+  TCodeLine line;
+  *instrs = NULL;
+  while (cbuf_nextLine(&code, &line))
+  {
+    if (cnt % LICM_CHUNK == 0)
+      *instrs = mmng_safeRealloc(*instrs, sizeof(TCodeInstr) * (cnt + LICM_CHUNK));
+    cbuf_parseInstr(line, &(*instrs)[cnt++]);
+  }
+  return cnt;
+}
+
+// true if instruction changes control flow or frames, temporary variables have to hold their values there
+bool licm_isBoundary(TCodeInstr *instr)
+{
+  return cbuf_isBlockEnd(instr) || cbuf_isOp(instr, 0, "LABEL") || cbuf_isOp(instr, 0, "PUSHFRAME") ||
+    cbuf_isOp(instr, 0, "CALL");
+}
+
+// count of assignments of variable in loop
+int licm_writeCnt(TLicmWrite *writes, int writeCnt, const char *name, unsigned len)
+{
+  for (int i = 0; i < writeCnt; i++)
+    if (writes[i].len == len && strncmp(writes[i].name, name, len) == 0)
+      return writes[i].cnt;
+  return 0;
+}
+
+// index of label in code, -1 if it is not in code
+int licm_findLabel(TCodeInstr *instrs, int cnt, const char *label, unsigned len)
+{
+  for (int i = 0; i < cnt; i++)
+    if (cbuf_isOp(&instrs[i], 0, "LABEL") && cbuf_isOpName(&instrs[i], 1, label, len))
+      return i;
+  return -1;
+}
+
+// index of POPFRAME which restores frames changed by PUSHFRAME on index from, cnt if it is not in code
+int licm_findPopFrame(TCodeInstr *instrs, int from, int cnt)
+{
+  int depth = 0;
+  for (int i = from; i < cnt; i++)
+  {
+    if (cbuf_isOp(&instrs[i], 0, "PUSHFRAME"))
+      depth++;
+    else if (cbuf_isOp(&instrs[i], 0, "POPFRAME") && --depth == 0)
+      return i;
+  }
+  return cnt;
+}
+
+// searches paths from index from, true if temporary variable is read on some of them before it is assigned
+bool licm_searchLive(TCodeInstr *instrs, int from, int cnt, const char *name, unsigned len, bool *visited)
+{
+  for (int i = from; i < cnt && !visited[i]; i++)
+  {
+    visited[i] = true;
+    TCodeInstr *instr = &instrs[i];
+    if (cbuf_isOp(instr, 0, "PUSHFRAME"))
+    {
+      // call sequence works with frames of called function, temporary frame of caller is back after POPFRAME
+      i = licm_findPopFrame(instrs, i, cnt);
+      continue;
+    }
+    for (int j = cbuf_firstRead(instr); j < instr->opCnt; j++)
+      if (cbuf_isOpName(instr, j, name, len))
+        return true;
+    if (cbuf_isOp(instr, 0, "CREATEFRAME") || (cbuf_hasDest(instr) && cbuf_isOpName(instr, 1, name, len)))
+      return false;
+    if (cbuf_isJump(instr))
+    {
+      int target = licm_findLabel(instrs, cnt, instr->ops[1], instr->opLens[1]);
+      if (target < 0 || licm_searchLive(instrs, target, cnt, name, len, visited))
+        return true; // jump out of loop is not followed
+      if (cbuf_isOp(instr, 0, "JUMP"))
+        return false;
+    }
+    else if (cbuf_isOp(instr, 0, "RETURN"))
+      return false;
+  }
+  return false;
+}
+
+// true if temporary variable is read after instruction on index from before it is assigned again
+bool licm_isLive(TCodeInstr *instrs, int from, int cnt, const char *name, unsigned len)
+{
+  bool *visited = mmng_safeMalloc(sizeof(bool) * (cnt + 1));
+  memset(visited, 0, sizeof(bool) * (cnt + 1));
+  bool isLive = false;
+  TCodeInstr *instr = &instrs[from];
+  if (cbuf_isJump(instr))
+  {
+    int target = licm_findLabel(instrs, cnt, instr->ops[1], instr->opLens[1]);
+    isLive = target < 0 || licm_searchLive(instrs, target, cnt, name, len, visited);
+  }
+  if (!isLive && !cbuf_isOp(instr, 0, "JUMP"))
+    isLive = licm_searchLive(instrs, cbuf_isOp(instr, 0, "PUSHFRAME") ? from : from + 1, cnt, name, len, visited);
+  mmng_safeFree(visited);
+  return isLive;
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+// Hoists invariant instructions of loop in front of it
+char *licm_hoistInvariants(const char *code, char **defs)
+{
+  *defs = NULL;
+  TCodeInstr *instrs = NULL;
+  int cnt = licm_parse(code, &instrs);
+
+  // assignments of local variables in loop
+  TLicmWrite *writes = NULL;
+  int writeCnt = 0;
+  for (int i = 0; i < cnt; i++)
+  {
+    if (!cbuf_hasDest(&instrs[i]) || !cbuf_opStartsWith(&instrs[i], 1, "LF@"))
+      continue;
+    int j = 0;
+    while (j < writeCnt && (writes[j].len != instrs[i].opLens[1] ||
+           strncmp(writes[j].name, instrs[i].ops[1], writes[j].len) != 0))
+      j++;
+    if (j == writeCnt)
+    {
+      if (writeCnt % LICM_CHUNK == 0)
+        writes = mmng_safeRealloc(writes, sizeof(TLicmWrite) * (writeCnt + LICM_CHUNK));
+      writes[j].name = instrs[i].ops[1];
+      writes[j].len = instrs[i].opLens[1];
+      writes[j].cnt = 0;
+      writeCnt++;
+    }
+    writes[j].cnt++;
+  }
+
+  TCodeBuf preHeader = { NULL, 0, 0 };
+  TCodeBuf body = { NULL, 0, 0 };
+  TCodeBuf defOut = { NULL, 0, 0 };
+  TLicmMapping *mappings = NULL;
+  int mappingCnt = 0;
+  int depth = 0; // depth of call sequences, frames are switched there
+  for (int i = 0; i < cnt; i++)
+  {
+    TCodeInstr *instr = &instrs[i];
+    if (cbuf_isOp(instr, 0, "POPFRAME"))
+      depth--;
+    else if (depth == 0 && cbuf_isOp(instr, 0, "CREATEFRAME"))
+    {
+      for (int m = 0; m < mappingCnt; m++)
+        mmng_safeFree(mappings[m].var);
+      mappingCnt = 0;
+    }
+    if (depth > 0 || cbuf_isOp(instr, 0, "POPFRAME"))
+    {
+      cbuf_print(&body, instr->ops[0], instr->ops[instr->opCnt - 1] + instr->opLens[instr->opCnt - 1] - instr->ops[0]);
+      cbuf_printStr(&body, "\n");
+      continue;
+    }
+
+    // operands with substituted temporary variables, invariant instruction has all operands invariant
+    const char *ops[CBUF_MAX_OPERANDS];
+    unsigned opLens[CBUF_MAX_OPERANDS];
+    bool isInvariant = cbuf_isPure(instr);
+    for (int j = 0; j < instr->opCnt; j++)
+    {
+      ops[j] = instr->ops[j];
+      opLens[j] = instr->opLens[j];
+      if (j < cbuf_firstRead(instr))
+        continue;
+      for (int m = 0; m < mappingCnt; m++)
+        if (cbuf_isOpName(instr, j, mappings[m].temp, mappings[m].len))
+        {
+          ops[j] = mappings[m].var;
+          opLens[j] = strlen(mappings[m].var);
+        }
+      bool isConst = strncmp(ops[j], "int@", 4) == 0 || strncmp(ops[j], "float@", 6) == 0 ||
+        strncmp(ops[j], "string@", 7) == 0 || strncmp(ops[j], "bool@", 5) == 0;
+      bool isLocal = strncmp(ops[j], "LF@", 3) == 0;
+      if (!isConst && !(isLocal && licm_writeCnt(writes, writeCnt, ops[j], opLens[j]) == 0))
+        isInvariant = false;
+    }
+
+    if (licm_isBoundary(instr))
+    {
+      // temporary variables used after boundary get their values back, boundary itself reads substituted operands
+      for (int m = 0; m < mappingCnt; m++)
+      {
+        if (licm_isLive(instrs, i, cnt, mappings[m].temp, mappings[m].len))
+        {
+          cbuf_printStr(&body, "MOVE ");
+          cbuf_print(&body, mappings[m].temp, mappings[m].len);
+          cbuf_printStr(&body, " ");
+          cbuf_printStr(&body, mappings[m].var);
+          cbuf_printStr(&body, "\n");
+        }
+      }
+      for (int j = 0; j < instr->opCnt; j++)
+      {
+        cbuf_print(&body, ops[j], opLens[j]);
+        cbuf_printStr(&body, (j + 1 < instr->opCnt) ? " " : "\n");
+      }
+      for (int m = 0; m < mappingCnt; m++)
+        mmng_safeFree(mappings[m].var);
+      mappingCnt = 0;
+      if (cbuf_isOp(instr, 0, "PUSHFRAME"))
+        depth++;
+      continue;
+    }
+
+    TCodeBuf *out = &body;
+    char *var = NULL;
+    if (isInvariant && cbuf_opStartsWith(instr, 1, "TF@%T") && cbuf_isOp(instr, 0, "MOVE"))
+    {
+      // copy of invariant value, uses of temporary variable are replaced by value right away
+      var = mmng_safeMalloc(sizeof(char) * (opLens[2] + 1));
+      memcpy(var, ops[2], opLens[2]);
+      var[opLens[2]] = '\0';
+      out = NULL;
+    }
+    else if (isInvariant && cbuf_opStartsWith(instr, 1, "TF@%T"))
+    {
+      // result is stored to new auxiliary variable in pre-header
+      var = mmng_safeMalloc(sizeof(char) * 32);
+      sprintf(var, "LF@%%inv%u", licmVarCnt++);
+      cbuf_printStr(&defOut, "DEFVAR ");
+      cbuf_printStr(&defOut, var);
+      cbuf_printStr(&defOut, "\n");
+      ops[1] = var;
+      opLens[1] = strlen(var);
+      out = &preHeader;
+    }
+    else if (isInvariant && cbuf_opStartsWith(instr, 1, "LF@%inv") &&
+             licm_writeCnt(writes, writeCnt, instr->ops[1], instr->opLens[1]) == 1)
+    {
+      // pre-header of inner loop, its variable is assigned only here
+      for (int w = 0; w < writeCnt; w++)
+        if (writes[w].len == instr->opLens[1] && strncmp(writes[w].name, instr->ops[1], writes[w].len) == 0)
+          writes[w].cnt = 0;
+      out = &preHeader;
+    }
+
+    for (int j = 0; out != NULL && j < instr->opCnt; j++)
+    {
+      cbuf_print(out, ops[j], opLens[j]);
+      cbuf_printStr(out, (j + 1 < instr->opCnt) ? " " : "\n");
+    }
+
+    // assignment ends mapping of temporary variable, hoisted assignment starts new one
+    if (cbuf_hasDest(instr))
+    {
+      for (int m = 0; m < mappingCnt; m++)
+        if (cbuf_isOpName(instr, 1, mappings[m].temp, mappings[m].len))
+        {
+          mmng_safeFree(mappings[m].var);
+          mappings[m--] = mappings[--mappingCnt];
+        }
+    }
+    if (var != NULL)
+    {
+      if (mappingCnt % LICM_CHUNK == 0)
+        mappings = mmng_safeRealloc(mappings, sizeof(TLicmMapping) * (mappingCnt + LICM_CHUNK));
+      mappings[mappingCnt].temp = instr->ops[1];
+      mappings[mappingCnt].len = instr->opLens[1];
+      mappings[mappingCnt].var = var;
+      mappingCnt++;
+    }
+  }
+
+  for (int m = 0; m < mappingCnt; m++)
+    mmng_safeFree(mappings[m].var);
+  if (mappings != NULL)
+    mmng_safeFree(mappings);
+  if (writes != NULL)
+    mmng_safeFree(writes);
+  if (instrs != NULL)
+    mmng_safeFree(instrs);
+
+  if (preHeader.text == NULL)
+  {
+    if (body.text != NULL)
+      mmng_safeFree(body.text);
+    return NULL;
+  }
+  cbuf_print(&preHeader, body.text, body.len);
+  mmng_safeFree(body.text);
+  cbuf_print(&defOut, "", 0);
+  *defs = defOut.text;
+  return preHeader.text;
+}
+
+void licm_beginFunction()
+{
+  licmVarCnt = 0;
+}
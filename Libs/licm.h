@@ -0,0 +1,39 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    licm.h
+ * \brief   Loop-invariant code motion
+ *
+ * Package moves computations whose result is the same in every iteration out of code of one loop.
+ * Variable is invariant when it is not assigned anywhere in the loop, instruction is invariant when
+ * it cannot fail, has no side effect and all its operands are constants or invariant variables.
+ * Invariant instructions are moved to pre-header in front of the loop and their results are stored
+ * in auxiliary variables %inv<n> of local frame (like %to and %step of for loop), uses of original
+ * temporary variable are replaced by them.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _Licm
+#define _Licm
+
+/**
+ * Hoists invariant instructions of loop in front of it
+ *
+ * \param code code of whole loop, starting by label of loop head
+ * \param defs output of definitions (DEFVAR) of new auxiliary variables, which have to be printed
+ *             on start of local frame
+ * \returns new code of loop preceded by pre-header or NULL if nothing was hoisted
+ * \note Memory of result and defs is allocated here and free has to be called.
+ */
+char *licm_hoistInvariants(const char *code, char **defs);
+
+/**
+ * Starts numbering of auxiliary variables of new function (variables are in its local frame),
+ * so code of function does not depend on previous functions
+ */
+void licm_beginFunction();
+
+#endif // _Licm
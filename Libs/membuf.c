@@ -0,0 +1,92 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    membuf.c
+ * \brief   Growing memory buffer of compiler drivers
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "membuf.h"
+
+#define MBUF_CHUNK 4096
+
+void *mbuf_alloc(void *pointer, size_t size)
+{
+  void *newPointer = realloc(pointer, size);
+  if (newPointer == NULL)
+  {
+    fprintf(stderr, "\033[31;1mInternal runtime error (99):\033[0m Allocation error outside of compilation.\n");
+    exit(99);
+  }
+  return newPointer;
+}
+
+void mbuf_append(TMemBuf *buffer, const char *data, unsigned len)
+{
+  if (buffer->len + len + 1 > buffer->cap)
+  {
+    while (buffer->len + len + 1 > buffer->cap)
+      buffer->cap = (buffer->cap == 0) ? MBUF_CHUNK : buffer->cap * 2;
+    buffer->data = mbuf_alloc(buffer->data, buffer->cap);
+  }
+  memcpy(buffer->data + buffer->len, data, len);
+  buffer->len += len;
+  buffer->data[buffer->len] = '\0';
+}
+
+void mbuf_output(const char *data, unsigned len, void *userData)
+{
+  mbuf_append((TMemBuf *)userData, data, len);
+}
+
+bool mbuf_readFile(TMemBuf *buffer, const char *path)
+{
+  FILE *file = fopen(path, "rb");
+  if (file == NULL)
+    return false;
+  buffer->len = 0;
+  mbuf_append(buffer, "", 0);
+  char chunk[MBUF_CHUNK];
+  size_t len;
+  while ((len = fread(chunk, sizeof(char), MBUF_CHUNK, file)) > 0)
+    mbuf_append(buffer, chunk, len);
+  bool isOk = !ferror(file);
+  fclose(file);
+  return isOk;
+}
+
+bool mbuf_writeFile(TMemBuf *buffer, const char *path)
+{
+  // temporary file is unique for process and thread, concurrent writers never share it
+  char *tmpPath = mbuf_alloc(NULL, strlen(path) + 48);
+  sprintf(tmpPath, "%s.tmp%ld.%lx", path, (long)getpid(), (unsigned long)pthread_self());
+  FILE *file = fopen(tmpPath, "wb");
+  bool isOk = file != NULL;
+  if (isOk)
+  {
+    isOk = fwrite(buffer->data, sizeof(char), buffer->len, file) == buffer->len;
+    isOk = fclose(file) == 0 && isOk;
+    isOk = isOk && rename(tmpPath, path) == 0;
+    if (!isOk)
+      remove(tmpPath);
+  }
+  free(tmpPath);
+  return isOk;
+}
+
+void mbuf_free(TMemBuf *buffer)
+{
+  free(buffer->data);
+  buffer->data = NULL;
+  buffer->len = 0;
+  buffer->cap = 0;
+}
@@ -0,0 +1,72 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    membuf.h
+ * \brief   Growing memory buffer of compiler drivers
+ *
+ * Buffer is used outside of compilation (batch, server, cache), so it is not allocated by memory
+ * manager, which belongs to context of one compilation. Allocation error terminates process.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _MemBuf
+#define _MemBuf
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Growing memory buffer, data are always terminated by zero
+ */
+typedef struct {
+  char *data;     /*!< content of buffer, NULL if nothing was appended yet */
+  unsigned len;   /*!< length of content */
+  unsigned cap;   /*!< allocated size of data */
+} TMemBuf;
+
+/**
+ * Allocation outside of compilation
+ *
+ * \param pointer allocated memory or NULL
+ * \param size new size of memory
+ * \returns reallocated memory
+ */
+void *mbuf_alloc(void *pointer, size_t size);
+
+/**
+ * Appends data to buffer
+ *
+ * \param buffer buffer
+ * \param data data
+ * \param len length of data
+ */
+void mbuf_append(TMemBuf *buffer, const char *data, unsigned len);
+
+/**
+ * Output of compilation into buffer (TIfjcOutput), user data is buffer
+ */
+void mbuf_output(const char *data, unsigned len, void *userData);
+
+/**
+ * Reads whole file into buffer, previous content is replaced
+ *
+ * \returns false if file cannot be read
+ */
+bool mbuf_readFile(TMemBuf *buffer, const char *path);
+
+/**
+ * Writes buffer to file atomically, temporary file is written and renamed to path
+ *
+ * \returns false if file cannot be written
+ */
+bool mbuf_writeFile(TMemBuf *buffer, const char *path);
+
+/**
+ * Frees content of buffer
+ */
+void mbuf_free(TMemBuf *buffer);
+
+#endif // _MemBuf
@@ -11,8 +11,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include "mmng.h"
 #include "apperr.h"
+#include "compilerctx.h"
 
 // =============================================================================
 // ================= Iternal data structures definition ========================
@@ -23,6 +25,10 @@ typedef struct PItem *TMMPItem;
 struct PItem {
   void *pointer;
   TMMPItem next;
+  #ifdef MMNG_PROFILE
+  size_t size;      // allocated size of pointer
+  int site;         // index of call site which allocated pointer, -1 if table of sites is full
+  #endif // MMNG_PROFILE
 };
 
 // table of all allocated pointers
@@ -33,8 +39,130 @@ struct PList {
 };
 
 
-// global internal instance of list of pointers
-TMMPList GLBPointerList;
+// internal instance of list of pointers is part of actual compiler context
+#define GLBPointerList (GLBCompilerCtx->pointerList)
+
+#ifdef MMNG_PROFILE
+
+#define MMNG_SITE_CNT 1024    // capacity of table of call sites
+#define MMNG_HIST_CNT 16      // buckets of histogram of sizes (powers of two)
+#define MMNG_REPORT_SITES 20  // count of call sites in report
+
+// allocations of one call site
+typedef struct {
+  const char *file;
+  int line;
+  unsigned long long count;
+  unsigned long long bytes;
+  size_t liveBytes;
+  size_t peakBytes;
+} TMMSite;
+
+// profile of allocations of one compilation
+struct MMProfile {
+  size_t liveBytes;
+  size_t peakBytes;
+  unsigned long long count;
+  unsigned long long bytes;
+  unsigned long long histogram[MMNG_HIST_CNT];
+  TMMSite sites[MMNG_SITE_CNT];   // open addressing by line
+  unsigned siteCnt;
+};
+
+#define GLBProfile (GLBCompilerCtx->mmProfile)
+
+// =============================================================================
+// ======================= Profile implementation ==============================
+// =============================================================================
+
+// index of call site in table, new site is added, -1 if table is full
+int mmng_profileSite(const char *file, int line)
+{
+  if (GLBProfile->siteCnt >= MMNG_SITE_CNT)
+    return -1;
+  unsigned i = (unsigned)line % MMNG_SITE_CNT;
+  for (; GLBProfile->sites[i].file != NULL; i = (i + 1) % MMNG_SITE_CNT)
+  {
+    TMMSite *site = &GLBProfile->sites[i];
+    if (site->line == line && (site->file == file || strcmp(site->file, file) == 0))
+      return i;
+  }
+  GLBProfile->sites[i].file = file;
+  GLBProfile->sites[i].line = line;
+  GLBProfile->siteCnt++;
+  return i;
+}
+
+// records allocation of item
+void mmng_profileAlloc(TMMPItem item, size_t size, const char *file, int line)
+{
+  unsigned bucket = 0;
+  while (bucket < MMNG_HIST_CNT - 1 && ((size_t)16 << bucket) < size)
+    bucket++;
+  GLBProfile->histogram[bucket]++;
+  GLBProfile->count++;
+  GLBProfile->bytes += size;
+  GLBProfile->liveBytes += size;
+  if (GLBProfile->liveBytes > GLBProfile->peakBytes)
+    GLBProfile->peakBytes = GLBProfile->liveBytes;
+
+  item->size = size;
+  item->site = mmng_profileSite(file, line);
+  if (item->site >= 0)
+  {
+    TMMSite *site = &GLBProfile->sites[item->site];
+    site->count++;
+    site->bytes += size;
+    site->liveBytes += size;
+    if (site->liveBytes > site->peakBytes)
+      site->peakBytes = site->liveBytes;
+  }
+}
+
+// records release of memory of item
+void mmng_profileRelease(TMMPItem item)
+{
+  GLBProfile->liveBytes -= item->size;
+  if (item->site >= 0)
+    GLBProfile->sites[item->site].liveBytes -= item->size;
+}
+
+// orders call sites by peak of live bytes descending
+int mmng_profileCompareSites(const void *a, const void *b)
+{
+  const TMMSite *siteA = *(const TMMSite * const *)a;
+  const TMMSite *siteB = *(const TMMSite * const *)b;
+  if (siteA->peakBytes != siteB->peakBytes)
+    return (siteA->peakBytes < siteB->peakBytes) ? 1 : -1;
+  return (siteA->bytes < siteB->bytes) ? 1 : (siteA->bytes > siteB->bytes) ? -1 : 0;
+}
+
+// prints profile to diagnostics of compilation
+void mmng_profileReport()
+{
+  ctx_printError("Memory profile: peak %zu B, live at teardown %zu B, %llu allocations of %llu B\n",
+    GLBProfile->peakBytes, GLBProfile->liveBytes, GLBProfile->count, GLBProfile->bytes);
+
+  ctx_printError("  sizes:");
+  for (unsigned i = 0; i < MMNG_HIST_CNT; i++)
+    if (GLBProfile->histogram[i] > 0)
+      ctx_printError(" %s%zu B: %llu", (i < MMNG_HIST_CNT - 1) ? "<=" : ">", (size_t)16 << ((i < MMNG_HIST_CNT - 1) ? i : i - 1),
+        GLBProfile->histogram[i]);
+  ctx_printError("\n");
+
+  const TMMSite *sites[MMNG_SITE_CNT];
+  unsigned siteCnt = 0;
+  for (unsigned i = 0; i < MMNG_SITE_CNT; i++)
+    if (GLBProfile->sites[i].file != NULL)
+      sites[siteCnt++] = &GLBProfile->sites[i];
+  qsort(sites, siteCnt, sizeof(const TMMSite *), mmng_profileCompareSites);
+  ctx_printError("  call sites by peak of live bytes:\n");
+  for (unsigned i = 0; i < siteCnt && i < MMNG_REPORT_SITES; i++)
+    ctx_printError("    %s:%d: peak %zu B, %llu allocations of %llu B\n", sites[i]->file, sites[i]->line,
+      sites[i]->peakBytes, sites[i]->count, sites[i]->bytes);
+}
+
+#endif // MMNG_PROFILE
 
 // =============================================================================
 // ======================= TMMPItem implementation ==============================
@@ -71,10 +199,10 @@ TMMPList TMMPList_create()
 }
 
 // adds item with pointer on the end of list
-void TMMPList_addPointer(TMMPList list, void *pointer)
+TMMPItem TMMPList_addPointer(TMMPList list, void *pointer)
 {
   if (pointer == NULL)
-    return;
+    return NULL;
 
   TMMPItem newItem = TMMPItem_create();
 
@@ -87,6 +215,7 @@ void TMMPList_addPointer(TMMPList list, void *pointer)
 
   if (list->head == NULL)
     list->head = newItem;
+  return newItem;
 }
 
 /**
@@ -100,10 +229,12 @@ bool TMMPList_deletePointer(TMMPList list, void *pointer)
 
   TMMPItem actItem = list->head;
   TMMPItem prevItem = NULL;
+  unsigned long long steps = 1;
   while(actItem != NULL)
   {
     if (actItem->pointer == pointer)
     {
+      STATS_WALK(steps);
       if (prevItem != NULL)
         prevItem->next = actItem->next;
 
@@ -113,15 +244,34 @@ bool TMMPList_deletePointer(TMMPList list, void *pointer)
       if (list->tail == actItem)
         list->tail = prevItem;
 
+      #ifdef MMNG_PROFILE
+      mmng_profileRelease(actItem);
+      #endif // MMNG_PROFILE
       free(actItem);
       return true;
     }
     prevItem = actItem;
     actItem = actItem->next;
+    steps++;
   }
+  STATS_WALK(steps - 1);
   return false;
 }
 
+// finds list item holding given pointer, NULL if pointer is not in list
+TMMPItem TMMPList_findPointer(TMMPList list, void *pointer)
+{
+  if (pointer == NULL)
+    return NULL;
+
+  TMMPItem actItem = list->head;
+  unsigned long long steps = 0;
+  for (; actItem != NULL && actItem->pointer != pointer; steps++)
+    actItem = actItem->next;
+  STATS_WALK((actItem != NULL) ? steps + 1 : steps);
+  return actItem;
+}
+
 // =============================================================================
 // ====================== support function ====================================
 // =============================================================================
@@ -129,10 +279,10 @@ bool TMMPList_deletePointer(TMMPList list, void *pointer)
 // error if GLBPointerList is not initialized
 void assertIfNotInit()
 {
-  if (GLBPointerList == NULL)
+  if (GLBCompilerCtx == NULL || GLBPointerList == NULL)
   {
-    fprintf( stderr, "\033[31;1mError:\033[0m Memory manager is not initialized.\n");
-    exit(internalErr);
+    ctx_printError("\033[31;1mError:\033[0m Memory manager is not initialized.\n");
+    ctx_raiseError(internalErr);
   }
 }
 
@@ -146,10 +296,24 @@ void mmng_init()
   if (GLBPointerList != NULL)
     apperr_runtimeError("mmng_init(): Memory manager is already initialized.");
   GLBPointerList = TMMPList_create();
+
+  #ifdef MMNG_PROFILE
+  // profile is not allocated by memory manager, so it does not count itself
+  GLBProfile = malloc(sizeof(struct MMProfile));
+  if (GLBProfile == NULL)
+    apperr_runtimeError("mmng_init(): Allocation of memory profile failed.");
+  memset(GLBProfile, 0, sizeof(struct MMProfile));
+  #endif // MMNG_PROFILE
 }
 
 // Safe allocation
-void *mmng_safeMalloc(size_t size)
+void *(mmng_safeMalloc)(size_t size)
+{
+  return mmng_safeMallocAt(size, NULL, 0);
+}
+
+// Safe allocation of given call site
+void *mmng_safeMallocAt(size_t size, const char *file, int line)
 {
   assertIfNotInit();
 
@@ -157,23 +321,56 @@ void *mmng_safeMalloc(size_t size)
   if (pointer == NULL)
     apperr_runtimeError("mmng_safeMalloc(): Allocation error.");
 
-  TMMPList_addPointer(GLBPointerList, pointer);
+  TMMPItem item = TMMPList_addPointer(GLBPointerList, pointer);
+  STATS_INC(allocs);
+  #ifdef MMNG_PROFILE
+  if (item != NULL)
+    mmng_profileAlloc(item, size, file, line);
+  #else
+  (void)item;
+  (void)file;
+  (void)line;
+  #endif // MMNG_PROFILE
   return pointer;
 }
 
 // Reallocate allocated memory of given pointer to new size.
-void *mmng_safeRealloc(void *pointer, size_t size)
+void *(mmng_safeRealloc)(void *pointer, size_t size)
+{
+  return mmng_safeReallocAt(pointer, size, NULL, 0);
+}
+
+// Reallocate allocated memory of given pointer to new size at given call site.
+void *mmng_safeReallocAt(void *pointer, size_t size, const char *file, int line)
 {
   assertIfNotInit();
 
+  // item has to be found before realloc, old pointer is not valid after it
+  TMMPItem item = TMMPList_findPointer(GLBPointerList, pointer);
+
   void *newPointer = realloc(pointer, size);
   if (newPointer == NULL)
     apperr_runtimeError("mmng_safeRealloc(): Reallocation error.");
 
-  // delete old pointer
-  TMMPList_deletePointer(GLBPointerList, pointer);
+  STATS_INC(reallocs);
+
   // store new pointer
-  TMMPList_addPointer(GLBPointerList, newPointer);
+  if (item != NULL)
+  {
+    item->pointer = newPointer;
+    #ifdef MMNG_PROFILE
+    mmng_profileRelease(item);
+    #endif // MMNG_PROFILE
+  }
+  else
+    item = TMMPList_addPointer(GLBPointerList, newPointer);
+  #ifdef MMNG_PROFILE
+  if (item != NULL)
+    mmng_profileAlloc(item, size, file, line);
+  #else
+  (void)file;
+  (void)line;
+  #endif // MMNG_PROFILE
   return newPointer;
 }
 
@@ -182,10 +379,40 @@ void mmng_freeAll()
 {
   assertIfNotInit();
 
-  while (GLBPointerList->head != NULL)
-    mmng_safeFree(GLBPointerList->head->pointer);
+  #ifdef MMNG_PROFILE
+  mmng_profileReport();
+  #endif // MMNG_PROFILE
+
+  // whole list is released in one pass, items do not have to be unlinked one by one
+  TMMPItem actItem = GLBPointerList->head;
+  while (actItem != NULL)
+  {
+    TMMPItem nextItem = actItem->next;
+    free(actItem->pointer);
+    free(actItem);
+    STATS_INC(frees);
+    actItem = nextItem;
+  }
   free(GLBPointerList);
   GLBPointerList = NULL;
+
+  #ifdef MMNG_PROFILE
+  free(GLBProfile);
+  GLBProfile = NULL;
+  #endif // MMNG_PROFILE
+}
+
+// Ends memory manager without freeing memory
+void mmng_abandonAll()
+{
+  assertIfNotInit();
+
+  #ifdef MMNG_PROFILE
+  mmng_profileReport();
+  GLBProfile = NULL;
+  #endif // MMNG_PROFILE
+
+  GLBPointerList = NULL;
 }
 
 // Safe free
@@ -194,7 +421,10 @@ void mmng_safeFree(void *pointer)
   assertIfNotInit();
 
   if (TMMPList_deletePointer(GLBPointerList, pointer))
+  {
     free(pointer);
+    STATS_INC(frees);
+  }
   else
     apperr_runtimeError("mmng_safeFree(): Pointer can't be freed. Pointer is not part of internal pointer evidence.");
 }
@@ -9,6 +9,11 @@
  * Operations are treated and all errors are handled by freeing memory and terminating program with corresponding error description.
  * Therefore there is no need for another external checks of allocation results. This makes better surence of proper work with memmory.
  *
+ * When built with MMNG_PROFILE defined (make profile), allocations are tracked by call sites
+ * (__FILE__ and __LINE__ of mmng_safeMalloc and mmng_safeRealloc) and profile of compilation is
+ * printed to diagnostics by mmng_freeAll: peak and live bytes, histogram of sizes and call sites
+ * with the highest peak of live bytes.
+ *
  * \author  Petr Fusek (xfusek08)
  * \date    19.10.2017 - Petr Fusek
  * \todo all errors redo for Application Error library
@@ -49,14 +54,51 @@ void *mmng_safeMalloc(size_t size);
  */
 void *mmng_safeRealloc(void *pointer, size_t size);
 
+/**
+ * Safe allocation of given call site (\ref mmng_safeMalloc)
+ *
+ * \param   size_t    size of memory to be allocated
+ * \param   char *    source file of call site, used only by profile
+ * \param   int       line of call site, used only by profile
+ * \retval  void *    pointer to allocated memory
+ */
+void *mmng_safeMallocAt(size_t size, const char *file, int line);
+
+/**
+ * Reallocation of given call site (\ref mmng_safeRealloc)
+ *
+ * \param   void *    pointer to allocated memory, if NULL new memory is allocated
+ * \param   size_t    size of memory to be allocated
+ * \param   char *    source file of call site, used only by profile
+ * \param   int       line of call site, used only by profile
+ * \retval  void *    new pointer to reallocated memmory
+ */
+void *mmng_safeReallocAt(void *pointer, size_t size, const char *file, int line);
+
+#ifdef MMNG_PROFILE
+#define mmng_safeMalloc(size) mmng_safeMallocAt((size), __FILE__, __LINE__)
+#define mmng_safeRealloc(pointer, size) mmng_safeReallocAt((pointer), (size), __FILE__, __LINE__)
+#endif // MMNG_PROFILE
+
 /**
  * Free all allocated memory
  *
  * Function safely frees all allocated memory including internal data structures.
+ * Profile of allocations is printed before when it is enabled.
  * After calling this function program should end or memory manager has to be initialized again.
  */
 void mmng_freeAll();
 
+/**
+ * End of memory manager without freeing memory
+ *
+ * All allocated memory including internal data structures is left to be released by the operating
+ * system at exit of process, which follows immediately. Memory manager has to be initialized again
+ * before next allocation. It is not meant for processes which go on compiling (server, batch)
+ * or which are checked for leaks.
+ */
+void mmng_abandonAll();
+
 /**
  * Safe free
  *
@@ -0,0 +1,391 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    parallel.c
+ * \brief   Parallel code generation of functions
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "parallel.h"
+#include "compilerctx.h"
+#include "mmng.h"
+#include "apperr.h"
+#include "scanner.h"
+#include "rparser.h"
+#include "utils.h"
+
+/**
+ * Argument of function signature
+ */
+typedef struct ParArg {
+  char *ident;
+  DataType dataType;
+  struct ParArg *next;
+} *TParArg;
+
+/**
+ * Immutable signature of function, signatures are shared by jobs
+ */
+typedef struct ParSig {
+  char *key;
+  char *label;
+  DataType returnType;
+  bool isDefined;
+  TParArg args;
+  struct ParSig *next;  /*!< previous signature in source code */
+} *TParSig;
+
+/**
+ * Code generation of one function
+ */
+typedef struct ParJob {
+  const char *src;      /*!< source code of main compilation */
+  unsigned srcLen;
+  char *label;          /*!< label of function */
+  unsigned srcPos;      /*!< offset of line with definition */
+  int lineNumber;       /*!< number of line with definition */
+  TParSig sigs;         /*!< signatures visible to definition, newest first */
+  char *code;           /*!< generated code, NULL until job is done */
+  unsigned len;
+  int result;           /*!< error code of compilation */
+  bool isDone;
+} *TParJob;
+
+/**
+ * Pool of worker threads
+ */
+struct Parallel {
+  pthread_t *threads;
+  unsigned threadCnt;
+  pthread_mutex_t lock;     /*!< lock of jobs and stop flag */
+  pthread_cond_t jobReady;  /*!< signaled when job is added or pool is stopped */
+  pthread_cond_t jobDone;   /*!< signaled when job is done */
+  TParJob *jobs;            /*!< jobs in order of source code */
+  unsigned jobCnt;
+  unsigned jobCap;
+  unsigned nextJob;         /*!< index of next job to be taken by worker */
+  bool isStopped;
+  bool isFinished;          /*!< code of all jobs is filled to main compilation */
+  TIfjcOutput diagnostics;  /*!< diagnostics of main compilation */
+  void *diagnosticsData;
+  TParSig sigs;             /*!< all signatures, newest first */
+};
+
+// =============================================================================
+// ====================== support functions ====================================
+// =============================================================================
+
+// copy of string by malloc, NULL if there is not enough memory
+char *par_strdup(const char *str)
+{
+  char *copy = malloc(strlen(str) + 1);
+  if (copy != NULL)
+    strcpy(copy, str);
+  return copy;
+}
+
+// reports allocation error in main compilation
+void *par_checkAlloc(void *ptr)
+{
+  if (ptr == NULL)
+    apperr_runtimeError("Parallel code generation: allocation error.");
+  return ptr;
+}
+
+// frees signature and its arguments
+void par_freeSig(TParSig sig)
+{
+  while (sig->args != NULL)
+  {
+    TParArg next = sig->args->next;
+    free(sig->args->ident);
+    free(sig->args);
+    sig->args = next;
+  }
+  free(sig->key);
+  free(sig->label);
+  free(sig);
+}
+
+/**
+ * Signatures referenced by body of function
+ */
+typedef struct {
+  TParSig sigs;         /*!< signatures visible to definition */
+  TParSig *used;        /*!< signatures of identifiers of body, newer first for every identifier */
+  unsigned usedCnt;
+  unsigned usedCap;
+  EGrSymb prevType;     /*!< type of previous token */
+} TParVisit;
+
+// collects signatures of identifiers of function read ahead, reading stops on the end of function
+bool par_visitToken(SToken *token, void *userData)
+{
+  TParVisit *visit = userData;
+  if (token->type == ident && token->symbol != NULL)
+  {
+    for (TParSig sig = visit->sigs; sig != NULL; sig = sig->next)
+    {
+      if (strcmp(sig->key, token->symbol->key) == 0)
+      {
+        if (visit->usedCnt == visit->usedCap)
+        {
+          visit->usedCap += 16;
+          visit->used = mmng_safeRealloc(visit->used, sizeof(TParSig) * visit->usedCap);
+        }
+        visit->used[visit->usedCnt++] = sig;
+        break;
+      }
+    }
+  }
+  bool isEnd = visit->prevType == kwEnd && token->type == kwFunction;
+  visit->prevType = token->type;
+  return !isEnd;
+}
+
+// compiles function of job, it is process of context of worker
+void par_processJob(void *arg)
+{
+  TParJob job = arg;
+  scan_seek(job->srcPos, job->lineNumber);
+
+  // only functions referenced by definition are inserted, all visible functions would make
+  // compilation of every job as slow as compilation of whole program
+  TParVisit visit = { job->sigs, NULL, 0, 0, eol };
+  scan_lookAhead(par_visitToken, &visit);
+  for (unsigned i = 0; i < visit.usedCnt; i++)
+  {
+    TParSig sig = visit.used[i];
+    TSymbol func = symbt_findOrInsertSymb(sig->key);
+    if (func->type == symtFuction)
+      continue;
+    func->type = symtFuction;
+    func->data.funcData.label = util_StrHardCopy(sig->label);
+    func->data.funcData.returnType = sig->returnType;
+    func->data.funcData.isDefined = sig->isDefined;
+    func->data.funcData.arguments = TArgList_create();
+    for (TParArg arg = sig->args; arg != NULL; arg = arg->next)
+      func->data.funcData.arguments->insert(func->data.funcData.arguments, arg->ident, arg->dataType);
+  }
+  if (visit.used != NULL)
+    mmng_safeFree(visit.used);
+
+  unsigned len;
+  const char *code = rparser_processFunction(&len);
+  // code is copied out of memory manager of worker context, which is freed after process
+  job->code = malloc(len + 1);
+  if (job->code == NULL)
+    apperr_runtimeError("Parallel code generation: allocation error.");
+  memcpy(job->code, code, len);
+  job->code[len] = '\0';
+  job->len = len;
+}
+
+// worker thread, compiles jobs until pool is stopped
+void *par_worker(void *arg)
+{
+  TParallel parallel = arg;
+  TCompilerCtx ctx = ifjc_createCtx();
+  if (ctx != NULL)
+    ifjc_setDiagnostics(ctx, par_discard, NULL);
+
+  while (true)
+  {
+    pthread_mutex_lock(&parallel->lock);
+    while (!parallel->isStopped && parallel->nextJob >= parallel->jobCnt)
+      pthread_cond_wait(&parallel->jobReady, &parallel->lock);
+    if (parallel->isStopped)
+    {
+      pthread_mutex_unlock(&parallel->lock);
+      break;
+    }
+    TParJob job = parallel->jobs[parallel->nextJob++];
+    pthread_mutex_unlock(&parallel->lock);
+
+    job->result = (ctx != NULL)
+      ? ctx_run(ctx, job->src, job->srcLen, par_discard, NULL, par_processJob, job)
+      : internalErr;
+
+    pthread_mutex_lock(&parallel->lock);
+    job->isDone = true;
+    pthread_cond_broadcast(&parallel->jobDone);
+    pthread_mutex_unlock(&parallel->lock);
+  }
+
+  if (ctx != NULL)
+    ifjc_destroyCtx(ctx);
+  return NULL;
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+TParallel par_create(unsigned threadCnt, TIfjcOutput diagnostics, void *diagnosticsData)
+{
+  TParallel parallel = malloc(sizeof(struct Parallel));
+  if (parallel == NULL)
+    return NULL;
+  memset(parallel, 0, sizeof(struct Parallel));
+  parallel->diagnostics = diagnostics;
+  parallel->diagnosticsData = diagnosticsData;
+  parallel->threads = malloc(sizeof(pthread_t) * threadCnt);
+  if (parallel->threads == NULL)
+  {
+    free(parallel);
+    return NULL;
+  }
+  pthread_mutex_init(&parallel->lock, NULL);
+  pthread_cond_init(&parallel->jobReady, NULL);
+  pthread_cond_init(&parallel->jobDone, NULL);
+
+  for (unsigned i = 0; i < threadCnt; i++)
+    if (pthread_create(&parallel->threads[parallel->threadCnt], NULL, par_worker, parallel) == 0)
+      parallel->threadCnt++;
+  if (parallel->threadCnt == 0)
+  {
+    par_destroy(parallel);
+    return NULL;
+  }
+  return parallel;
+}
+
+void par_discard(const char *data, unsigned len, void *userData)
+{
+  (void)data;
+  (void)len;
+  (void)userData;
+}
+
+void par_addSignature(TSymbol func)
+{
+  TParallel parallel = GLBCompilerCtx->parallel;
+  if (parallel == NULL)
+    return;
+
+  TParSig sig = par_checkAlloc(malloc(sizeof(struct ParSig)));
+  memset(sig, 0, sizeof(struct ParSig));
+  sig->next = parallel->sigs;
+  parallel->sigs = sig; // signature is owned by pool from now
+  sig->key = par_checkAlloc(par_strdup(func->key));
+  sig->label = par_checkAlloc(par_strdup(func->data.funcData.label));
+  sig->returnType = func->data.funcData.returnType;
+  sig->isDefined = func->data.funcData.isDefined;
+  TParArg *tail = &sig->args;
+  TArgList args = func->data.funcData.arguments;
+  for (TArgument arg = (args != NULL) ? args->head : NULL; arg != NULL; arg = arg->next)
+  {
+    *tail = par_checkAlloc(malloc(sizeof(struct ParArg)));
+    memset(*tail, 0, sizeof(struct ParArg));
+    (*tail)->ident = par_checkAlloc(par_strdup(arg->ident));
+    (*tail)->dataType = arg->dataType;
+    tail = &(*tail)->next;
+  }
+}
+
+bool par_dispatchFunction(const char *label, unsigned srcPos, int lineNumber)
+{
+  TParallel parallel = GLBCompilerCtx->parallel;
+  if (parallel == NULL)
+    return false;
+
+  TParJob job = par_checkAlloc(malloc(sizeof(struct ParJob)));
+  memset(job, 0, sizeof(struct ParJob));
+  job->label = par_strdup(label);
+  if (job->label == NULL)
+  {
+    free(job);
+    par_checkAlloc(NULL);
+  }
+  job->src = GLBCompilerCtx->src;
+  job->srcLen = GLBCompilerCtx->srcLen;
+  job->srcPos = srcPos;
+  job->lineNumber = lineNumber;
+  job->sigs = parallel->sigs;
+
+  pthread_mutex_lock(&parallel->lock);
+  if (parallel->jobCnt == parallel->jobCap)
+  {
+    unsigned cap = (parallel->jobCap == 0) ? 64 : parallel->jobCap * 2;
+    TParJob *jobs = realloc(parallel->jobs, sizeof(TParJob) * cap);
+    if (jobs == NULL)
+    {
+      pthread_mutex_unlock(&parallel->lock);
+      free(job->label);
+      free(job);
+      par_checkAlloc(NULL);
+    }
+    parallel->jobs = jobs;
+    parallel->jobCap = cap;
+  }
+  parallel->jobs[parallel->jobCnt++] = job;
+  pthread_cond_signal(&parallel->jobReady);
+  pthread_mutex_unlock(&parallel->lock);
+  return true;
+}
+
+void par_finish()
+{
+  TParallel parallel = GLBCompilerCtx->parallel;
+  if (parallel == NULL)
+    return;
+
+  for (unsigned i = 0; i < parallel->jobCnt; i++)
+  {
+    pthread_mutex_lock(&parallel->lock);
+    TParJob job = parallel->jobs[i];
+    while (!job->isDone)
+      pthread_cond_wait(&parallel->jobDone, &parallel->lock);
+    pthread_mutex_unlock(&parallel->lock);
+
+    if (job->result != 0)
+    {
+      mmng_freeAll();
+      ctx_raiseError(job->result);
+    }
+    util_printUnitCodeOf(job->label, job->code, job->len);
+  }
+
+  // rest of compilation is the same as sequential one, its errors are reported
+  parallel->isFinished = true;
+  GLBCompilerCtx->parallel = NULL;
+  GLBCompilerCtx->diagnostics = parallel->diagnostics;
+  GLBCompilerCtx->diagnosticsData = parallel->diagnosticsData;
+}
+
+bool par_destroy(TParallel parallel)
+{
+  pthread_mutex_lock(&parallel->lock);
+  parallel->isStopped = true;
+  pthread_cond_broadcast(&parallel->jobReady);
+  pthread_mutex_unlock(&parallel->lock);
+  for (unsigned i = 0; i < parallel->threadCnt; i++)
+    pthread_join(parallel->threads[i], NULL);
+
+  bool isFinished = parallel->isFinished;
+  for (unsigned i = 0; i < parallel->jobCnt; i++)
+  {
+    TParJob job = parallel->jobs[i];
+    free(job->label);
+    free(job->code);
+    free(job);
+  }
+  while (parallel->sigs != NULL)
+  {
+    TParSig next = parallel->sigs->next;
+    par_freeSig(parallel->sigs);
+    parallel->sigs = next;
+  }
+  free(parallel->jobs);
+  free(parallel->threads);
+  pthread_mutex_destroy(&parallel->lock);
+  pthread_cond_destroy(&parallel->jobDone);
+  pthread_cond_destroy(&parallel->jobReady);
+  free(parallel);
+  return isFinished;
+}
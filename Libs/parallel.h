@@ -0,0 +1,89 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    parallel.h
+ * \brief   Parallel code generation of functions
+ *
+ * Main thread parses program as usual, but bodies of function definitions are only skipped
+ * and passed to pool of worker threads. Every job carries position of definition in source code
+ * and immutable snapshot of signatures of functions declared or defined before it, so worker
+ * compiles function in its own compiler context exactly as it would be compiled sequentially
+ * (code of one function does not depend on code of other functions, see incremental.h).
+ * Code of jobs is filled to code units of main compilation in order of source code.
+ *
+ * Errors are not reported until code of all functions is generated (par_finish()), any error
+ * before makes whole parallel compilation fail and it is repeated sequentially by ifjc_compile.
+ * Rest of compilation after par_finish() is the same as sequential one and its errors are final.
+ *
+ * All memory of package is allocated by malloc, it outlives compilation of main thread.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _Parallel
+#define _Parallel
+
+#include <stdbool.h>
+#include "ifjc.h"
+#include "symtable.h"
+
+/**
+ * Pool of worker threads of one compilation
+ */
+typedef struct Parallel *TParallel;
+
+/**
+ * Starts worker threads
+ *
+ * \param threadCnt count of worker threads
+ * \param diagnostics diagnostics of main compilation, used after par_finish()
+ * \param diagnosticsData user data passed to diagnostics
+ * \returns new pool or NULL if no thread can be started
+ */
+TParallel par_create(unsigned threadCnt, TIfjcOutput diagnostics, void *diagnosticsData);
+
+/**
+ * Output of diagnostics which throws messages away
+ */
+void par_discard(const char *data, unsigned len, void *userData);
+
+/**
+ * Makes signature of function visible to following definitions
+ *
+ * Does nothing if actual compilation is not parallel.
+ *
+ * \param func symbol of declared or defined function
+ */
+void par_addSignature(TSymbol func);
+
+/**
+ * Passes definition of function to worker threads
+ *
+ * Code of function is filled to its code unit by par_finish().
+ *
+ * \param label label of function (and of its code unit)
+ * \param srcPos offset of line with definition in source code
+ * \param lineNumber number of line with definition
+ * \returns false if actual compilation is not parallel and function has to be compiled here
+ */
+bool par_dispatchFunction(const char *label, unsigned srcPos, int lineNumber);
+
+/**
+ * Waits for all dispatched functions and fills their code to code units
+ *
+ * If any function is not compiled, compilation ends with its error. Otherwise compilation is not
+ * parallel anymore and diagnostics of main compilation are restored.
+ */
+void par_finish();
+
+/**
+ * Stops worker threads and frees pool
+ *
+ * \param parallel pool
+ * \returns true if par_finish() succeeded, so result of compilation is final
+ */
+bool par_destroy(TParallel parallel);
+
+#endif // _Parallel
@@ -22,9 +22,14 @@
 #include "apperr.h"
 #include "scanner.h"
 #include "mmng.h"
+#include "constpool.h"
 #include "syntaxanalyzer.h"
 #include "exprsemanticanalyzer.h"
 #include "utils.h"
+#include "licm.h"
+#include "incremental.h"
+#include "parallel.h"
+#include "compilerctx.h"
 
 void raiseUnexpToken(SToken *actToken, EGrSymb expected);
 
@@ -48,7 +53,8 @@ void raiseUnexpToken(SToken *actToken, EGrSymb expected);
 // ========================== Global variables =================================
 // =============================================================================
 
-unsigned int GLBFrameCnt = 0;
+// counter of frames is part of actual compiler context
+#define GLBFrameCnt (GLBCompilerCtx->frameCnt)
 
 // =============================================================================
 // ========== Declaration of recursive Grammar NON-terminal functions ==========
@@ -71,7 +77,7 @@ void ck_NT_PARAM_EXT( 		                  // continue of param list
 void ck_NT_STAT_LIST(SToken *actToken); 		// list of statements
 void ck_NT_STAT(SToken *actToken); 					// one statement
 void ck_NT_DOIN(SToken *actToken); 					// body of do..loop statement
-void ck_NT_DOIN_WU(                         // until or while neterminal
+bool ck_NT_DOIN_WU(                         // until or while neterminal
   SToken *actToken,
   char *doLabel,
   bool isOnEnd);
@@ -136,30 +142,128 @@ void setDefautValue(char *varIdent, DataType dt, bool directPrint)
   }
 
   if (directPrint)
-    printf("MOVE %s %s\n", varIdent, typeconst);
+    printDirectInstruction("MOVE %s %s\n", varIdent, typeconst);
   else
     printInstruction("MOVE %s %s\n", varIdent, typeconst);
 }
 
-// balance numeric symbol types
-void balanceNumTypes(TSymbol symb1, TSymbol symb2)
+// balance numeric symbol types, symb2 is converted to type of symb1
+// constants are converted in compile time and replaced by converted constant from pool, variable is converted
+// (or only moved) to variable dest, so type of symb2 itself is never changed, returns balanced symbol
+TSymbol balanceNumTypes(TSymbol symb1, TSymbol symb2, TSymbol dest)
 {
-  if (symb1->dataType == dtInt && symb2->dataType == dtFloat)
+  if (symb2->type == symtConstant) // is constant
   {
-    symb2->dataType = dtInt;
-    if (symb2->type == symtConstant) // is constant
-      symb2->data.intVal = syntx_doubleToInt(symb1->data.doubleVal);
-    else // is variable
-      printInstruction("FLOAT2R2EINT %s %s\n", symb2->ident, symb2->ident);
+    if (symb1->dataType == dtInt && symb2->dataType == dtFloat)
+      return cpool_int(syntx_doubleToInt(symb2->data.doubleVal));
+    if (symb1->dataType == dtFloat && symb2->dataType == dtInt)
+      return cpool_double(syntx_intToDouble(symb2->data.intVal));
+    return symb2;
   }
+  if (symb1->dataType == dtInt && symb2->dataType == dtFloat)
+    printInstruction("FLOAT2R2EINT %s %s\n", dest->ident, symb2->ident);
   else if (symb1->dataType == dtFloat && symb2->dataType == dtInt)
+    printInstruction("INT2FLOAT %s %s\n", dest->ident, symb2->ident);
+  else
+    printInstruction("MOVE %s %s\n", dest->ident, symb2->ident);
+  dest->dataType = symb1->dataType;
+  return dest;
+}
+
+// replaces self call in tail position (code of return expression from codeBase) by jump to start of function body
+// arguments stay on data stack, so they are popped right to parameters of actual frame
+// returns true if call was replaced
+bool lowerSelfTailCall(unsigned codeBase, const char *funcLabel)
+{
+  char *code = util_cutCode(codeBase);
+  char *callLabel = util_StrConcatenate(funcLabel, "\n");
+  char *callLine = util_StrConcatenate("CALL ", callLabel);
+  char *call = strstr(code, callLine);
+  char *callStart = NULL;
+  if (call != NULL && strstr(call + 1, "\nCALL ") == NULL)
+  {
+    // after call has to be only move of returned value to %retval
+    char *afterCall = call + strlen(callLine);
+    char *dest = NULL;
+    if (strncmp(afterCall, "PUSHS TF@%retval\nPOPFRAME\nPOPS ", 31) == 0)
+      dest = afterCall + 31;
+    unsigned destLen = (dest != NULL) ? strcspn(dest, "\n") : 0;
+    if (dest != NULL && (strcmp(dest + destLen, "\n") == 0 || (strncmp(dest + destLen, "\nMOVE LF@%retval ", 17) == 0 &&
+        strncmp(dest + destLen + 17, dest, destLen) == 0 && strcmp(dest + 2 * destLen + 17, "\n") == 0)))
+    {
+      // call sequence starts by last PUSHFRAME before call
+      for (char *found = strstr(code, "PUSHFRAME\nCREATEFRAME\n"); found != NULL && found < call;
+           found = strstr(found + 1, "PUSHFRAME\nCREATEFRAME\n"))
+        if (found == code || found[-1] == '\n')
+          callStart = found;
+    }
+  }
+  mmng_safeFree(callLine);
+  mmng_safeFree(callLabel);
+  if (callStart == NULL)
+  {
+    printLongInstruction(strlen(code), "%s", code);
+    mmng_safeFree(code);
+    return false;
+  }
+
+  if (callStart > code)
+    printLongInstruction(callStart - code, "%.*s", (int)(callStart - code), code);
+  // parameters in the same order as in call sequence (DEFVAR TF@param, POPS TF@param)
+  for (char *param = strstr(callStart, "\nPOPS TF@"); param != NULL && param < call; param = strstr(param + 1, "\nPOPS TF@"))
+  {
+    unsigned len = strcspn(param + 9, "\n");
+    printLongInstruction(len, "POPS LF@%.*s\n", (int)len, param + 9);
+  }
+  printInstruction("JUMP %s$tailrec\n", funcLabel);
+  mmng_safeFree(code);
+  return true;
+}
+
+// prints end of for loop, jumps back to loop while iterator does not pass to value
+// (iterator is not greater than to value, for negative step it is not less than to value)
+void printForTest(char *forlabel, TSymbol iterSymb, TSymbol toSymb, bool isDown)
+{
+  printInstruction("%s LF@%%forcond %s ", (isDown) ? "LT" : "GT", iterSymb->ident);
+  printSymbolToOperand(toSymb);
+  printInstruction("\n");
+  printInstruction("JUMPIFNEQ %s$loop LF@%%forcond bool@true\n", forlabel);
+}
+
+// hoists invariant code of loop which starts on loopBase (by label of its head) in front of the loop
+void hoistLoopInvariants(unsigned loopBase)
+{
+  char *code = util_cutCode(loopBase);
+  char *defs = NULL;
+  char *hoisted = licm_hoistInvariants(code, &defs);
+  if (hoisted != NULL)
   {
-    symb2->dataType = dtFloat;
-    if (symb2->type == symtConstant) // is constant
-      symb2->data.doubleVal = syntx_intToDouble(symb2->data.intVal);
-    else // is variable
-      printInstruction("INT2FLOAT %s %s\n", symb2->ident, symb2->ident);
+    printDirectInstruction("%s", defs);
+    printLongInstruction(strlen(hoisted), "%s", hoisted);
+    mmng_safeFree(hoisted);
+    mmng_safeFree(defs);
   }
+  else
+    printLongInstruction(strlen(code), "%s", code);
+  mmng_safeFree(code);
+}
+
+// creates temporary frame of function in its prologue with definitions of all used auxiliary variables
+void defineTempFrame()
+{
+  printDirectInstruction("CREATEFRAME\n");
+  for (unsigned i = 0; i < syntx_getUsedTemps(); i++)
+    printDirectInstruction("DEFVAR TF@%%T%u\n", i);
+}
+
+// prints buffered code of main scope when it exceeds limit, statements of main scope are not waiting
+// for any following code, so code between them is compiled separately
+void streamMainCode()
+{
+  if (!symbt_isMainScope() || !util_isBufferFull())
+    return;
+  par_finish(); // functions are printed before first block
+  util_streamCode(symbt_getActFuncLabel(), syntx_getUsedTemps(), false);
 }
 
 // function for defining function
@@ -170,6 +274,11 @@ void processFunction(SToken *actToken)
   bool isDeclared = false;
   DataType retType = dtUnspecified;
   TArgList parList = TArgList_create();
+  unsigned cachedLen = 0;
+  const char *cachedCode = incr_probeFunction(&cachedLen); // code of function from previous compilation
+  unsigned lineStart;
+  int lineNumber;
+  scan_lineStart(&lineStart, &lineNumber); // position of definition for parallel code generation
 
   CHECK_TOKEN(actToken, kwFunction);
   NEXT_CHECK_TOKEN(actToken, ident);
@@ -194,8 +303,12 @@ void processFunction(SToken *actToken)
   else // attempt of redeclaration
     ERR_SYMB_REDEF();
 
-  // body of function
+  // body of function, it starts by label which is target of self tail calls
+  printInstruction("LABEL %s$tailrec\n", actSymbol->data.funcData.label);
   symbt_pushFrame(actSymbol->data.funcData.label, false, false, false); // lets create local variable frame for function
+  syntx_resetMaxLiveTemps();
+  syntx_resetUsedTemps();
+  licm_beginFunction();
 
   NEXT_CHECK_TOKEN(actToken, opLeftBrc);
   NEXT_TOKEN(actToken);
@@ -252,9 +365,34 @@ void processFunction(SToken *actToken)
     TArgList_destroy(parList);
 
 
-  printf("LABEL %s\n", actSymbol->data.funcData.label);
-  printf("PUSHFRAME\n");
-  printf("DEFVAR LF@%%retval\n");
+  util_beginCodeUnit(actSymbol->data.funcData.label);
+  bool isDispatched = cachedCode == NULL && par_dispatchFunction(actSymbol->data.funcData.label, lineStart, lineNumber);
+  if (!isDeclared)
+    par_addSignature(actSymbol); // function is visible to following definitions
+  if (cachedCode != NULL || isDispatched)
+  {
+    // function is not changed or its code is generated by other thread, body is only skipped
+    if (cachedCode != NULL)
+    {
+      util_printUnitCode(cachedCode, cachedLen);
+      incr_storeFunction(cachedCode, cachedLen);
+    }
+    EGrSymb prevType;
+    do
+    {
+      prevType = actToken->type;
+      NEXT_TOKEN(actToken);
+      if (actToken->type == eof)
+        scan_raiseCodeError(syntaxErr, "File unexpectedly ended.", actToken);
+    } while (prevType != kwEnd || actToken->type != kwFunction);
+    NEXT_CHECK_TOKEN(actToken, eol);
+    mmng_safeFree(util_cutCode(0)); // label of tail recursion
+    symbt_popFrame();
+    return;
+  }
+  printDirectInstruction("LABEL %s\n", actSymbol->data.funcData.label);
+  printDirectInstruction("PUSHFRAME\n");
+  printDirectInstruction("DEFVAR LF@%%retval\n");
   setDefautValue("LF@%retval", actSymbol->data.funcData.returnType, true);
   NEXT_TOKEN(actToken);
   ck_NT_STAT_LIST(actToken);
@@ -264,7 +402,14 @@ void processFunction(SToken *actToken)
   printInstruction("LABEL %s$epilog\n", actSymbol->data.funcData.label);
   printInstruction("POPFRAME\n");
   printInstruction("RETURN\n");
+  #ifdef DEBUG
+  fprintf(stderr, "Function %s: max live temporaries %u\n", actSymbol->data.funcData.label, syntx_getMaxLiveTemps());
+  #endif // DEBUG
+  defineTempFrame();
   symbt_popFrame();
+  unsigned codeLen;
+  const char *code = util_actUnitCode(&codeLen);
+  incr_storeFunction(code, codeLen);
 }
 
 // definition or redefinition as variable
@@ -277,7 +422,7 @@ void defOrRedefVariable(TSymbol symbolVar)
     if (!symbt_isVarDefined(symbolVar->key))
     {
       symbt_defVarIdent(symbolVar->key);
-      printf("DEFVAR %s\n", symbolVar->ident);
+      printDirectInstruction("DEFVAR %s\n", symbolVar->ident);
     }
   }
   else
@@ -286,6 +431,7 @@ void defOrRedefVariable(TSymbol symbolVar)
     {
       if (!symbt_pushRedefinition(symbolVar))
         scan_raiseCodeError(semanticErr, "Cannot redefine variable in the same scope.", NULL);
+      printDirectInstruction("DEFVAR %s\n", symbolVar->ident);
     }
     else if (symbolVar->type == symtConstant)
       scan_raiseCodeError(syntaxErr, "Cannot redefine constant as variable.", NULL);
@@ -365,10 +511,13 @@ void ck_NT_PROG(SToken *actToken)
 {
   // 1. NT_PROG -> NT_DD NT_SCOPE eof
   ck_NT_DD(actToken);
-  printf("LABEL %s\n", symbt_getActFuncLabel()); // main function
-  printf("CREATEFRAME\n");
-  printf("PUSHFRAME\n");
-  printf("CREATEFRAME\n");
+  util_beginCodeUnit(symbt_getActFuncLabel());
+  printDirectInstruction("LABEL %s\n", symbt_getActFuncLabel()); // main function
+  printDirectInstruction("CREATEFRAME\n");
+  printDirectInstruction("PUSHFRAME\n");
+  syntx_resetMaxLiveTemps();
+  syntx_resetUsedTemps();
+  licm_beginFunction();
 
   // check if all declared functions are defined
   char *udenfFuncIdent = symbt_getUndefinedFunc();
@@ -385,6 +534,13 @@ void ck_NT_PROG(SToken *actToken)
     CHECK_TOKEN(actToken, eol);
     NEXT_CHECK_TOKEN(actToken, eof);
   }
+  #ifdef DEBUG
+  fprintf(stderr, "Function %s: max live temporaries %u\n", symbt_getActFuncLabel(), syntx_getMaxLiveTemps());
+  #endif // DEBUG
+  if (util_isStreamed())
+    util_streamCode(symbt_getActFuncLabel(), syntx_getUsedTemps(), true); // rest of main function
+  else
+    defineTempFrame();
 }
 
 // definitions and declarations section
@@ -423,6 +579,7 @@ void ck_NT_DD(SToken *actToken)
       NEXT_CHECK_TOKEN(actToken, kwAs);
       NEXT_CHECK_TOKEN(actToken, dataType);
       actSymbol->data.funcData.returnType = actToken->dataType; // token is return type
+      par_addSignature(actSymbol);
       NEXT_CHECK_TOKEN(actToken, eol);
       NEXT_TOKEN(actToken);
       // clean symbtable from arguments
@@ -573,6 +730,7 @@ void ck_NT_STAT_LIST(SToken *actToken)
     case kwFor:
       ck_NT_STAT(actToken);
       CHECK_TOKEN(actToken, eol);
+      streamMainCode();
       NEXT_TOKEN(actToken);
       ck_NT_STAT_LIST(actToken);
       break;
@@ -623,23 +781,33 @@ void ck_NT_STAT(SToken *actToken)
       NEXT_TOKEN(actToken);
       char *iflabel = symbt_getNewLocalLabel();
       symbt_pushFrame(iflabel, true, false, false);
-      TSymbol symbol = syntx_processExpression(actToken, NULL);
-      if (symbol->dataType != dtBool)
-        ERR_COND_TYPE();
+      char *elselabel = util_StrConcatenate(iflabel, "$else");
+      TSymbol symbol = syntx_processCondition(actToken, elselabel, false);
+      mmng_safeFree(elselabel);
+      // condition evaluated in compile time, one of branches is dead
+      bool isConstCond = symbol != NULL;
 
       CHECK_TOKEN(actToken, kwThen);
       NEXT_CHECK_TOKEN(actToken, eol);
-      printInstruction("JUMPIFNEQ %s$else ", iflabel);
-      printSymbolToOperand(symbol);
-      printInstruction(" bool@true\n");
+      if (isConstCond && !symbol->data.boolVal)
+        util_deadCodeBegin();
       symbt_pushFrame(iflabel, true, false, false);
       NEXT_TOKEN(actToken);
       ck_NT_STAT_LIST(actToken);
       symbt_popFrame();
-      printInstruction("JUMP %s$endif\n", iflabel);
-      printInstruction("LABEL %s$else\n", iflabel);
+      if (!isConstCond)
+      {
+        printInstruction("JUMP %s$endif\n", iflabel);
+        printInstruction("LABEL %s$else\n", iflabel);
+      }
+      else if (!symbol->data.boolVal)
+        util_deadCodeEnd();
+      else // then branch is always taken, rest is dead
+        util_deadCodeBegin();
       symbt_pushFrame(iflabel, true, false, false);
       ck_NT_INIF_EXT(actToken);
+      if (isConstCond && symbol->data.boolVal)
+        util_deadCodeEnd();
       CHECK_TOKEN(actToken, kwEnd);
       NEXT_CHECK_TOKEN(actToken, kwIf);
       symbt_popFrame();
@@ -656,13 +824,43 @@ void ck_NT_STAT(SToken *actToken)
       if (util_isBuildInFunc(actSymbol->key))
         scan_raiseCodeError(syntaxErr, "Redefinition of build-in function is not allowed.", actToken);
 
-      defOrRedefVariable(actSymbol);
+      // initializer of redefined variable reads variable of outer block, new variable is defined after it
+      bool isRedefinition = actSymbol->type == symtVariable;
+      if (!isRedefinition)
+        defOrRedefVariable(actSymbol);
 
       NEXT_CHECK_TOKEN(actToken, kwAs);
       NEXT_CHECK_TOKEN(actToken, dataType);
-      actSymbol->type = symtVariable;
-      actSymbol->dataType = actToken->dataType;
+      DataType varType = actToken->dataType;
       NEXT_TOKEN(actToken);
+      if (isRedefinition && actToken->type == opEq)
+      {
+        NEXT_TOKEN(actToken);
+        SToken rightOperand;
+        rightOperand.type = ident;
+        rightOperand.symbol = syntx_processExpression(actToken, NULL);
+        if (rightOperand.symbol == actSymbol)
+        {
+          // initializer is outer variable itself, its value is copied before the symbol is renamed
+          SToken temp = sytx_getFreeVar();
+          printInstruction("MOVE %s %s\n", temp.symbol->ident, actSymbol->ident);
+          temp.symbol->dataType = actSymbol->dataType;
+          rightOperand.symbol = temp.symbol;
+        }
+        defOrRedefVariable(actSymbol);
+        actSymbol->dataType = varType;
+        SToken leftOperand;
+        leftOperand.type = ident;
+        leftOperand.symbol = actSymbol;
+        SToken tokAsgn;
+        tokAsgn.type = asgn;
+        syntx_generateCode(&leftOperand, &tokAsgn, &rightOperand, NULL);
+        break;
+      }
+      if (isRedefinition)
+        defOrRedefVariable(actSymbol);
+      actSymbol->type = symtVariable;
+      actSymbol->dataType = varType;
       ck_NT_ASSINGEXT(actToken, actSymbol);
       break;
     // 14. NT_STAT -> ident opEq NT_EXPR (if ident is not function)
@@ -724,8 +922,10 @@ void ck_NT_STAT(SToken *actToken)
       {
         NEXT_TOKEN(actToken);
         TSymbol symbol = symbt_findOrInsertSymb("%retval");
+        unsigned codeBase = util_codePosition();
         syntx_processExpression(actToken, symbol);
-        printInstruction("JUMP %s$epilog\n", symbt_getActFuncLabel());
+        if (!lowerSelfTailCall(codeBase, symbt_getActFuncLabel()))
+          printInstruction("JUMP %s$epilog\n", symbt_getActFuncLabel());
       }
       else
         scan_raiseCodeError(syntaxErr, "Return can not be used outside of function.", actToken);
@@ -771,16 +971,13 @@ void ck_NT_STAT(SToken *actToken)
         scan_raiseCodeError(semanticErr, "To value has no valid data type. Only double or integer is allowed.", actToken);
       if (tmpToSymb->type == symtConstant)
       {
-        toSymb = tmpToSymb;
-        balanceNumTypes(actSymbol, toSymb);
+        toSymb = balanceNumTypes(actSymbol, tmpToSymb, NULL);
       }
-      else // variable
+      else // variable is converted once before loop to its typed copy
       {
         toSymb = symbt_findOrInsertSymb("%to");
         defOrRedefVariable(toSymb);
-        toSymb->dataType = tmpToSymb->dataType;
-        balanceNumTypes(actSymbol, toSymb);
-        printInstruction("MOVE %s %s\n", toSymb->ident, tmpToSymb->ident);
+        balanceNumTypes(actSymbol, tmpToSymb, toSymb);
       }
 
       // set STEP Value
@@ -789,31 +986,43 @@ void ck_NT_STAT(SToken *actToken)
         scan_raiseCodeError(semanticErr, "Step value has no valid data type. Only double or integer is allowed.", actToken);
       if (tmpStepSymb->type == symtConstant)
       {
-        stepSymb = tmpStepSymb;
-        balanceNumTypes(actSymbol, stepSymb);
+        stepSymb = balanceNumTypes(actSymbol, tmpStepSymb, NULL);
       }
-      else // variable
+      else // variable is converted once before loop to its typed copy
       {
         stepSymb = symbt_findOrInsertSymb("%step");
         defOrRedefVariable(stepSymb);
-        stepSymb->dataType = tmpStepSymb->dataType;
-        balanceNumTypes(actSymbol, stepSymb);
-        printInstruction("MOVE %s %s\n", stepSymb->ident, tmpStepSymb->ident);
+        balanceNumTypes(actSymbol, tmpStepSymb, stepSymb);
       }
 
       CHECK_TOKEN(actToken, eol);
       // end of for initialization
 
       NEXT_TOKEN(actToken);
-      // check condition
+      // direction of loop is known in compile time for constant step, otherwise it is checked once before loop
+      TSymbol downSymb = NULL;
+      bool isDown = false;
+      if (stepSymb->type == symtConstant)
+        isDown = (stepSymb->dataType == dtInt) ? stepSymb->data.intVal < 0 : stepSymb->data.doubleVal < 0;
+      else
+      {
+        downSymb = symbt_findOrInsertSymb("%fordown");
+        defOrRedefVariable(downSymb);
+        downSymb->dataType = dtBool;
+        printInstruction("LT %s %s %s\n", downSymb->ident, stepSymb->ident,
+          (stepSymb->dataType == dtInt) ? "int@0" : "float@0");
+      }
+      if (!symbt_isVarDefined("%forcond"))
+      {
+        symbt_defVarIdent("%forcond");
+        printDirectInstruction("DEFVAR LF@%%forcond\n");
+      }
+
+      // loop is rotated, condition is tested only on its end
+      unsigned loopBase = util_codePosition();
+      printInstruction("JUMP %s$fortest\n", forlabel);
       printInstruction("LABEL %s$loop\n", forlabel);
       symbt_pushFrame(forlabel, true, true, false);
-      printInstruction("DEFVAR TF@%%forisless\n");
-      printInstruction("GT TF@%%forisless %s ", actSymbol->ident);
-      //symbt_printSymb(toSymb);
-      printSymbolToOperand(toSymb);
-      printInstruction("\n");
-      printInstruction("JUMPIFEQ %s$loopend TF@%%forisless bool@true\n", forlabel);
 
       // inner statements
       ck_NT_STAT_LIST(actToken);
@@ -826,7 +1035,18 @@ void ck_NT_STAT(SToken *actToken)
       printInstruction("\n");
 
       symbt_popFrame();
-      printInstruction("JUMP %s$loop\n", forlabel);
+      printInstruction("LABEL %s$fortest\n", forlabel);
+      if (downSymb != NULL)
+      {
+        printInstruction("JUMPIFEQ %s$fordown %s bool@true\n", forlabel, downSymb->ident);
+        printForTest(forlabel, actSymbol, toSymb, false);
+        printInstruction("JUMP %s$loopend\n", forlabel);
+        printInstruction("LABEL %s$fordown\n", forlabel);
+        printForTest(forlabel, actSymbol, toSymb, true);
+      }
+      else
+        printForTest(forlabel, actSymbol, toSymb, isDown);
+      hoistLoopInvariants(loopBase);
       printInstruction("LABEL %s$loopend\n", forlabel);
       CHECK_TOKEN(actToken, kwNext);
       NEXT_TOKEN(actToken);
@@ -850,7 +1070,9 @@ void ck_NT_STAT(SToken *actToken)
 // first(NT_DOIN) = { first(NT_DOIN_WU) -> (21); eol -> (22) else -> (error)}
 void ck_NT_DOIN(SToken *actToken)
 {
+  bool isDead = false;
   char *dolabel = symbt_getNewLocalLabel();
+  unsigned loopBase = util_codePosition();
   printInstruction("LABEL %s$loop\n", dolabel);
   symbt_pushFrame(dolabel, true, false, true);
   switch (actToken->type)
@@ -858,7 +1080,9 @@ void ck_NT_DOIN(SToken *actToken)
     // 21. NT_DOIN -> NT_DOIN_WU eol NT_STAT_LIST kwLoop
     case kwWhile:
     case kwUntil:
-      ck_NT_DOIN_WU(actToken, dolabel, false);
+      isDead = ck_NT_DOIN_WU(actToken, dolabel, false);
+      if (isDead) // loop is never entered
+        util_deadCodeBegin();
       symbt_pushFrame(dolabel, true, false, false);
       CHECK_TOKEN(actToken, eol);
       NEXT_TOKEN(actToken);
@@ -867,6 +1091,8 @@ void ck_NT_DOIN(SToken *actToken)
       NEXT_TOKEN(actToken);
       symbt_popFrame();
       printInstruction("JUMP %s$loop\n", dolabel);
+      if (isDead)
+        util_deadCodeEnd();
       break;
     // 22. NT_DOIN -> eol NT_STAT_LIST kwLoop NT_DOIN_WU
     case eol:
@@ -884,6 +1110,7 @@ void ck_NT_DOIN(SToken *actToken)
       ERR_UNEXP_TOKEN();
       break;
   }
+  hoistLoopInvariants(loopBase);
   printInstruction("LABEL %s$loopend\n", dolabel);
   symbt_popFrame();
   mmng_safeFree(dolabel);
@@ -891,38 +1118,31 @@ void ck_NT_DOIN(SToken *actToken)
 
 // until or while neterminal
 // first(NT_DOIN_WU) = { kwWhile -> (23); kwUntil -> (24); else -> (epsilon) }
-void ck_NT_DOIN_WU(SToken *actToken, char *doLabel, bool isOnEnd)
+// returns true if condition is constant and loop is always left by it
+bool ck_NT_DOIN_WU(SToken *actToken, char *doLabel, bool isOnEnd)
 {
   TSymbol cond = NULL;
+  char *jumpLabel = NULL;
+  bool isWhile = actToken->type == kwWhile;
   switch (actToken->type)
   {
     // 23. NT_DOIN_WU -> kwWhile NT_EXPR
-    case kwWhile:
-      NEXT_TOKEN(actToken);
-      cond = syntx_processExpression(actToken, NULL);
-      if (cond->dataType != dtBool)
-        ERR_COND_TYPE();
-
-      printInstruction("%s %s$%s ",
-        (isOnEnd) ? "JUMPIFEQ" : "JUMPIFNEQ",
-        doLabel,
-        (isOnEnd) ? "loop" : "loopend");
-      printSymbolToOperand(cond);
-      printInstruction(" bool@true\n");
-      break;
     // 24. NT_DOIN_WU -> kwUntil NT_EXPR
+    case kwWhile:
     case kwUntil:
       NEXT_TOKEN(actToken);
-      cond = syntx_processExpression(actToken, NULL);
-      if (cond->dataType != dtBool)
-        ERR_COND_TYPE();
-
-      printInstruction("%s %s$%s ",
-        (isOnEnd) ? "JUMPIFNEQ" : "JUMPIFEQ",
-        doLabel,
-        (isOnEnd) ? "loop" : "loopend");
-      printSymbolToOperand(cond);
-      printInstruction(" bool@true\n");
+      // while jumps on true, until on false (on the end back to loop, on the start out of loop)
+      jumpLabel = util_StrConcatenate(doLabel, (isOnEnd) ? "$loop" : "$loopend");
+      cond = syntx_processCondition(actToken, jumpLabel, isOnEnd == isWhile);
+      mmng_safeFree(jumpLabel);
+
+      if (cond != NULL) // condition evaluated in compile time
+      {
+        bool isRepeated = cond->data.boolVal == isWhile;
+        if (isRepeated && isOnEnd)
+          printInstruction("JUMP %s$loop\n", doLabel);
+        return !isRepeated;
+      }
       break;
     // NT_DOIN_WU -> (epsilon)
     default:
@@ -930,6 +1150,7 @@ void ck_NT_DOIN_WU(SToken *actToken, char *doLabel, bool isOnEnd)
         printInstruction("JUMP %s$loop\n", doLabel);
       break;
   }
+  return false;
 }
 
 // step of for
@@ -946,13 +1167,7 @@ TSymbol ck_NT_FORSTEP(SToken *actToken)
       break;
     // NT_FORSTEP -> (epsilon)
     default:
-      result = symbt_findOrInsertSymb("1");
-      if (result->type != symtConstant)
-      {
-        result->type = symtConstant;
-        result->dataType = dtInt;
-        result->data.intVal = 1;
-      }
+      result = cpool_int(1);
       break;
   }
   return result;
@@ -970,20 +1185,32 @@ void ck_NT_INIF_EXT(SToken *actToken)
       char *endiflabel = symbt_getActLocalLabel();
       char *iflabel = symbt_getNewLocalLabel();
 
-      TSymbol symbol = syntx_processExpression(actToken, NULL);
-      if (symbol->dataType != dtBool)
-        ERR_COND_TYPE();
+      char *elselabel = util_StrConcatenate(iflabel, "$else");
+      TSymbol symbol = syntx_processCondition(actToken, elselabel, false);
+      mmng_safeFree(elselabel);
+      // condition evaluated in compile time, body or rest of branches is dead
+      bool isConstCond = symbol != NULL;
       CHECK_TOKEN(actToken, kwThen);
       NEXT_CHECK_TOKEN(actToken, eol);
-      printInstruction("JUMPIFNEQ %s$else %s bool@true\n", iflabel, symbol->ident);
+      if (isConstCond && !symbol->data.boolVal)
+        util_deadCodeBegin();
       symbt_pushFrame(iflabel, true, false, false);
       NEXT_TOKEN(actToken);
       ck_NT_STAT_LIST(actToken);
       symbt_popFrame();
-      printInstruction("JUMP %s$endif\n", endiflabel);
-      printInstruction("LABEL %s$else\n", iflabel);
+      if (!isConstCond)
+      {
+        printInstruction("JUMP %s$endif\n", endiflabel);
+        printInstruction("LABEL %s$else\n", iflabel);
+      }
+      else if (!symbol->data.boolVal)
+        util_deadCodeEnd();
+      else // this branch is always taken, rest is dead
+        util_deadCodeBegin();
       mmng_safeFree(iflabel);
       ck_NT_INIF_EXT(actToken);
+      if (isConstCond && symbol->data.boolVal)
+        util_deadCodeEnd();
       break;
     // 27. NT_INIF_EXT -> kwElse eol NT_STAT_LIST
     case kwElse:
@@ -1117,11 +1344,24 @@ void ck_NT_CYCLES_FOR(SToken *actToken, int *forCnt)
 void rparser_processProgram()
 {
   // start compile to code
-  printf(".IFJcode17\n");
-  printf("JUMP %s\n", symbt_getActFuncLabel());
+  util_beginCodeUnit(NULL);
+  printDirectInstruction(".IFJcode17\n");
+  printDirectInstruction("JUMP %s\n", symbt_getActFuncLabel());
   util_printBuildFunc();
   defineBuildInFuncSymbols();
   SToken token = scan_GetNextToken();
   ck_NT_PROG(&token);
   flushCode();
-}
\ No newline at end of file
+  par_finish(); // code of functions generated by other threads
+  // only functions called from main body are printed
+  util_printCodeUnits(symbt_getActFuncLabel());
+}
+
+const char *rparser_processFunction(unsigned *len)
+{
+  defineBuildInFuncSymbols();
+  SToken token = scan_GetNextToken();
+  CHECK_TOKEN((&token), kwFunction);
+  processFunction(&token);
+  return util_actUnitCode(len);
+}
@@ -20,9 +20,18 @@
 
 /**
  * Main function of parser.
- *
- * The only function in the intervace of module.
  */
 void rparser_processProgram();
 
+/**
+ * Compiles only definition of function which starts on actual line of scanner
+ *
+ * Used by parallel code generation (see parallel.h), symbols of functions visible
+ * to definition have to be in global frame already.
+ *
+ * \param len returns length of code
+ * \returns whole code unit of function
+ */
+const char *rparser_processFunction(unsigned *len);
+
 #endif // _RParser
@@ -14,10 +14,13 @@
 #include <stdbool.h>
 #include <ctype.h>
 #include <math.h>
+#include <setjmp.h>
 #include "scanner.h"
 #include "symtable.h"
+#include "constpool.h"
 #include "mmng.h"
 #include "apperr.h"
+#include "compilerctx.h"
 
 #define KWORDNUMBER 30
 #define DTYPENUMBER 4
@@ -26,23 +29,22 @@
 typedef struct LAnalyzer *TLAnalyzer;
 struct LAnalyzer {
   SToken lastToken;
-  int alocStr;
   int curentLine;
   int prevPosition;
   int position;
   int lineSize; //in CHUNKS
   char *line;
+  jmp_buf *lookAheadJump; // return point of scan_lookAhead() on lexical error, NULL outside of it
 };
 
-// global internal instance of lexical analyzer
-TLAnalyzer GLBScanner;
+// internal instance of lexical analyzer is part of actual compiler context
+#define GLBScanner (GLBCompilerCtx->scanner)
 
 //Lexical analyzer constructor
 TLAnalyzer TLAnalyzer_create()
 {
   TLAnalyzer newScanner = (TLAnalyzer)mmng_safeMalloc(sizeof(struct LAnalyzer));
 
-  newScanner->alocStr = 1;
   newScanner->curentLine = 0;
   newScanner->prevPosition = 0;
   newScanner->position = 0;
@@ -50,6 +52,7 @@ TLAnalyzer TLAnalyzer_create()
   newScanner->line = mmng_safeMalloc(sizeof(char) * CHUNK * newScanner->lineSize);
   newScanner->line[0] = '\0';
   newScanner->lastToken.type = eol;
+  newScanner->lookAheadJump = NULL;
 
   return newScanner;
 }
@@ -65,6 +68,9 @@ void scan_init()
 //Error function
 void scan_raiseCodeError(ErrType typchyby, char *message, SToken *token)
 {
+  // error found ahead is not reported, it is found again when code is really analyzed
+  if (GLBScanner->lookAheadJump != NULL)
+    longjmp(*GLBScanner->lookAheadJump, 1);
   apperr_codeError(
     typchyby,
     GLBScanner->curentLine,
@@ -80,7 +86,7 @@ void get_line()
 {
   GLBScanner->curentLine++;
   int charCounter = 0;
-  while(((GLBScanner->line[charCounter] = getchar()) != '\n'))
+  while(((GLBScanner->line[charCounter] = ctx_getChar()) != '\n'))
   {
     if(charCounter == (GLBScanner->lineSize * CHUNK - 2))
     {
@@ -202,7 +208,6 @@ SToken scan_GetNextToken()
   char *stringVal = NULL;
   bool boolVal = true;
   //helping variables
-  char *hasStr = NULL;
   int state = 0;
   int position = 0;
   bool allowed = false;
@@ -434,9 +439,6 @@ SToken scan_GetNextToken()
           type = symtConstant;
           dType = dtString;
           tokenID[position] = '\0';
-          hasStr = mmng_safeMalloc(sizeof(char) * floor(log10(abs(GLBScanner->alocStr))) + 4); //s@'number'\0
-          sprintf(hasStr, "s@%d", GLBScanner->alocStr);
-          GLBScanner->alocStr++;
           stringVal = util_StrHardCopy(tokenID);
         }
         else
@@ -589,28 +591,26 @@ SToken scan_GetNextToken()
   }
   //Filing returning token with values
   GLBScanner->lastToken.type = tokenType;
+  STATS_INC(tokens[tokenType]);
   if(tokenType == ident || tokenType == kwTrue || tokenType == kwFalse)
   {
-    if(type == symtConstant && dType == dtString && hasStr != NULL)
+    if(type == symtConstant) // constants are evided in pool of constants, not in symbol table
     {
-      symbol = symbt_findOrInsertSymb(hasStr);
-      mmng_safeFree(hasStr);
+      Data data;
+      if(dType == dtInt)
+        data.intVal = intVal;
+      else if(dType == dtFloat)
+        data.doubleVal = doubleVal;
+      else if(dType == dtString)
+        data.stringVal = stringVal;
+      else
+        data.boolVal = boolVal;
+      symbol = cpool_get(cpool_insert(dType, data));
+      if(stringVal != NULL)
+        mmng_safeFree(stringVal);
     }
     else
       symbol = symbt_findOrInsertSymb(tokenID);
-    if(type != symtUnknown)
-    {
-      symbol->type = type;
-      symbol->dataType = dType;
-    }
-    if(dType == dtInt)
-      symbol->data.intVal = intVal;
-    else if(dType == dtFloat)
-      symbol->data.doubleVal = doubleVal;
-    else if(dType == dtString)
-      symbol->data.stringVal = stringVal;
-    else if(dType == dtBool)
-      symbol->data.boolVal = boolVal;
   }
   SToken token;
   token.dataType = dType;
@@ -620,6 +620,59 @@ SToken scan_GetNextToken()
   return token;
 }
 
+bool scan_lookAhead(TScanVisitor visitor, void *userData)
+{
+  if (GLBCompilerCtx->src == NULL || GLBScanner->lookAheadJump != NULL)
+    return false; // standard input cannot be read again
+
+  // position in source and state of analyzer are restored after look ahead
+  struct LAnalyzer savedScanner = *GLBScanner;
+  unsigned savedSrcPos = GLBCompilerCtx->srcPos;
+  char *savedLine = mmng_safeMalloc(sizeof(char) * CHUNK * GLBScanner->lineSize);
+  memcpy(savedLine, GLBScanner->line, sizeof(char) * CHUNK * GLBScanner->lineSize);
+  // identifiers found ahead are inserted to temporary frame, symbols of outer frames are only found
+  symbt_pushFrame("$$lookahead", true, false, false);
+
+  jmp_buf lookAheadJump;
+  volatile bool isStopped = false;
+  GLBScanner->lookAheadJump = &lookAheadJump;
+  if (setjmp(lookAheadJump) == 0)
+  {
+    SToken token;
+    do
+    {
+      token = scan_GetNextToken();
+      isStopped = !visitor(&token, userData);
+    } while (!isStopped && token.type != eof);
+  }
+
+  symbt_popFrame();
+  savedScanner.line = GLBScanner->line; // line buffer can be only enlarged by look ahead
+  savedScanner.lineSize = GLBScanner->lineSize;
+  *GLBScanner = savedScanner;
+  memcpy(GLBScanner->line, savedLine, sizeof(char) * CHUNK * GLBScanner->lineSize);
+  mmng_safeFree(savedLine);
+  GLBCompilerCtx->srcPos = savedSrcPos;
+  return isStopped;
+}
+
+void scan_lineStart(unsigned *srcPos, int *lineNumber)
+{
+  // actual line is read whole, including new line
+  *srcPos = GLBCompilerCtx->srcPos - strlen(GLBScanner->line);
+  *lineNumber = GLBScanner->curentLine;
+}
+
+void scan_seek(unsigned srcPos, int lineNumber)
+{
+  GLBCompilerCtx->srcPos = srcPos;
+  GLBScanner->curentLine = lineNumber - 1;
+  GLBScanner->line[0] = '\0';
+  GLBScanner->position = 0;
+  GLBScanner->prevPosition = 0;
+  GLBScanner->lastToken.type = eol;
+}
+
 //destructor of LAnalyzer
 void scan_destroy()
 {
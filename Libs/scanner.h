@@ -48,6 +48,43 @@ void scan_init();
  */
 SToken scan_GetNextToken();
 
+/**
+ * Visitor of tokens read ahead
+ *
+ * \param token token read ahead
+ * \param userData user data given to scan_lookAhead()
+ * \returns false to stop reading ahead after this token
+ */
+typedef bool (*TScanVisitor)(SToken *token, void *userData);
+
+/**
+ * Reads tokens ahead of actual position and returns back
+ *
+ * Every token is passed to visitor until visitor stops reading. Position in source code stays
+ * unchanged, so following scan_GetNextToken() returns the same tokens again. Identifiers read ahead
+ * are inserted to temporary frame of symbol table, which is removed afterwards.
+ * Look ahead is possible only when source code is in memory (not read from standard input).
+ *
+ * \returns true if visitor stopped reading, false on the end of source code or on lexical error
+ */
+bool scan_lookAhead(TScanVisitor visitor, void *userData);
+
+/**
+ * Position of beginning of actual line in source code
+ *
+ * \param srcPos returns offset of line in source code
+ * \param lineNumber returns number of line
+ */
+void scan_lineStart(unsigned *srcPos, int *lineNumber);
+
+/**
+ * Continues analysis from beginning of line of source code in memory (see scan_lineStart())
+ *
+ * \param srcPos offset of line in source code
+ * \param lineNumber number of line
+ */
+void scan_seek(unsigned srcPos, int lineNumber);
+
 /**
  * Free LAnalyzer
  *
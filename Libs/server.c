@@ -0,0 +1,285 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    server.c
+ * \brief   Compilation server on unix socket
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <arpa/inet.h>
+#include "server.h"
+#include "ifjc.h"
+
+#define SERVER_BACKLOG 64
+#define SERVER_MAX_THREADS 256
+
+/**
+ * Server shared by workers
+ */
+typedef struct {
+  int listenFd;
+  TCompileCache cache;
+  unsigned maxBuffer;     /*!< limit of code buffer of main scope of every context (ifjc_setMaxBuffer) */
+  int acceptErr;          /*!< errno of failed accept which ended workers, 0 if none */
+  pthread_mutex_t lock;   /*!< lock of acceptErr */
+} TServer;
+
+// =============================================================================
+// ====================== support functions ====================================
+// =============================================================================
+
+// reads exactly len bytes, returns false on error or end of stream
+bool server_read(int fd, void *data, size_t len)
+{
+  char *pos = data;
+  while (len > 0)
+  {
+    ssize_t readCnt = read(fd, pos, len);
+    if (readCnt < 0 && errno == EINTR)
+      continue;
+    if (readCnt <= 0)
+      return false;
+    pos += readCnt;
+    len -= readCnt;
+  }
+  return true;
+}
+
+// writes exactly len bytes, returns false on error
+bool server_write(int fd, const void *data, size_t len)
+{
+  const char *pos = data;
+  while (len > 0)
+  {
+    ssize_t writeCnt = write(fd, pos, len);
+    if (writeCnt < 0 && errno == EINTR)
+      continue;
+    if (writeCnt <= 0)
+      return false;
+    pos += writeCnt;
+    len -= writeCnt;
+  }
+  return true;
+}
+
+bool server_readNumber(int fd, uint32_t *number)
+{
+  if (!server_read(fd, number, sizeof(uint32_t)))
+    return false;
+  *number = ntohl(*number);
+  return true;
+}
+
+// reads len bytes into buffer, previous content is replaced
+bool server_readBuffer(int fd, TMemBuf *buffer, uint32_t len)
+{
+  buffer->len = 0;
+  mbuf_append(buffer, "", 0);
+  char chunk[4096];
+  while (len > 0)
+  {
+    uint32_t chunkLen = (len < sizeof(chunk)) ? len : sizeof(chunk);
+    if (!server_read(fd, chunk, chunkLen))
+      return false;
+    mbuf_append(buffer, chunk, chunkLen);
+    len -= chunkLen;
+  }
+  return true;
+}
+
+// sends response with error of server, which is not error of compilation
+bool server_writeError(int fd, const char *message)
+{
+  uint32_t header[3] = { htonl(99), htonl(0), htonl(strlen(message)) };
+  return server_write(fd, header, sizeof(header)) && server_write(fd, message, strlen(message));
+}
+
+// compiles requests of connection until client closes it
+void server_serve(TServer *server, int fd, TCompilerCtx ctx, TMemBuf *diagnostics)
+{
+  TMemBuf src = { NULL, 0, 0 };
+  TMemBuf code = { NULL, 0, 0 };
+  uint32_t srcLen;
+  while (server_readNumber(fd, &srcLen))
+  {
+    if (srcLen > SERVER_MAX_SOURCE)
+    {
+      // rest of request is not read, so client gets reason and connection is closed
+      char message[128];
+      sprintf(message, "request rejected: source is longer than limit of server (%u B)\n", SERVER_MAX_SOURCE);
+      server_writeError(fd, message);
+      break;
+    }
+    if (!server_readBuffer(fd, &src, srcLen))
+      break;
+    code.len = 0;
+    diagnostics->len = 0;
+    int result = cache_compile(server->cache, ctx, src.data, src.len, mbuf_output, &code);
+    uint32_t header[3] = { htonl((uint32_t)result), htonl(code.len), htonl(diagnostics->len) };
+    if (!server_write(fd, header, sizeof(header))
+      || !server_write(fd, code.data, code.len)
+      || !server_write(fd, diagnostics->data, diagnostics->len))
+      break;
+  }
+  close(fd);
+  mbuf_free(&src);
+  mbuf_free(&code);
+}
+
+// worker thread, accepts connections and serves them one after another with its own compiler context
+void *server_worker(void *arg)
+{
+  TServer *server = arg;
+  TCompilerCtx ctx = ifjc_createCtx();
+  if (ctx == NULL)
+    return NULL;
+  TMemBuf diagnostics = { NULL, 0, 0 };
+  ifjc_setDiagnostics(ctx, mbuf_output, &diagnostics);
+  ifjc_setMaxBuffer(ctx, server->maxBuffer);
+  while (true)
+  {
+    int fd = accept(server->listenFd, NULL, NULL);
+    if (fd >= 0)
+    {
+      server_serve(server, fd, ctx, &diagnostics);
+      continue;
+    }
+    int acceptErr = errno;
+    if (acceptErr == EMFILE || acceptErr == ENFILE)
+    {
+      // out of descriptors, worker waits until some connection is closed
+      struct timespec delay = { 0, 10000000 };
+      nanosleep(&delay, NULL);
+    }
+    if (acceptErr == EINTR || acceptErr == ECONNABORTED || acceptErr == EMFILE || acceptErr == ENFILE)
+      continue;
+    pthread_mutex_lock(&server->lock);
+    if (server->acceptErr == 0)
+    {
+      server->acceptErr = acceptErr;
+      shutdown(server->listenFd, SHUT_RDWR); // accept of other workers fails as well
+    }
+    pthread_mutex_unlock(&server->lock);
+    break;
+  }
+  mbuf_free(&diagnostics);
+  ifjc_destroyCtx(ctx);
+  return NULL;
+}
+
+// fills address of unix socket, returns false if path is too long
+bool server_address(const char *socketPath, struct sockaddr_un *address)
+{
+  memset(address, 0, sizeof(struct sockaddr_un));
+  address->sun_family = AF_UNIX;
+  if (strlen(socketPath) >= sizeof(address->sun_path))
+    return false;
+  strcpy(address->sun_path, socketPath);
+  return true;
+}
+
+// removes socket left on path by previous server, any other file on path is kept
+void server_removeSocket(const char *socketPath)
+{
+  struct stat info;
+  if (lstat(socketPath, &info) == 0 && S_ISSOCK(info.st_mode))
+    unlink(socketPath);
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+int server_run(const char *socketPath, unsigned threadCnt, unsigned maxBuffer, TCompileCache cache)
+{
+  struct sockaddr_un address;
+  if (!server_address(socketPath, &address))
+  {
+    fprintf(stderr, "%s: path of socket is too long\n", socketPath);
+    return 99;
+  }
+  int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  server_removeSocket(socketPath);
+  if (listenFd < 0
+    || bind(listenFd, (struct sockaddr *)&address, sizeof(address)) != 0
+    || listen(listenFd, SERVER_BACKLOG) != 0)
+  {
+    fprintf(stderr, "%s: socket cannot be created (%s)\n", socketPath, strerror(errno));
+    if (listenFd >= 0)
+      close(listenFd);
+    return 99;
+  }
+
+  // client closing connection before response must not end server
+  signal(SIGPIPE, SIG_IGN);
+
+  if (threadCnt == 0)
+  {
+    long cpuCnt = sysconf(_SC_NPROCESSORS_ONLN);
+    threadCnt = (cpuCnt > 0) ? (unsigned)cpuCnt : 1;
+  }
+  if (threadCnt > SERVER_MAX_THREADS)
+    threadCnt = SERVER_MAX_THREADS;
+
+  // workers accept connections, others wait in backlog of socket until some worker is free
+  TServer server = { listenFd, cache, maxBuffer, 0, PTHREAD_MUTEX_INITIALIZER };
+  pthread_t threads[SERVER_MAX_THREADS];
+  unsigned startedCnt = 0;
+  for (unsigned i = 0; i < threadCnt; i++)
+    if (pthread_create(&threads[startedCnt], NULL, server_worker, &server) == 0)
+      startedCnt++;
+  if (startedCnt == 0)
+    server_worker(&server); // no thread can be created, connections are served by this thread
+  for (unsigned i = 0; i < startedCnt; i++)
+    pthread_join(threads[i], NULL);
+
+  errno = (server.acceptErr != 0) ? server.acceptErr : ENOMEM; // otherwise no worker got compiler context
+  fprintf(stderr, "%s: accepting of connections failed (%s)\n", socketPath, strerror(errno));
+  pthread_mutex_destroy(&server.lock);
+  close(listenFd);
+  server_removeSocket(socketPath);
+  return 99;
+}
+
+int server_connect(const char *socketPath)
+{
+  struct sockaddr_un address;
+  if (!server_address(socketPath, &address))
+    return -1;
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd >= 0 && connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0)
+  {
+    close(fd);
+    fd = -1;
+  }
+  return fd;
+}
+
+bool server_compile(int fd, const char *src, unsigned len, TMemBuf *code, TMemBuf *diagnostics, int *result)
+{
+  uint32_t srcLen = htonl(len);
+  uint32_t header[3];
+  if (len > SERVER_MAX_SOURCE
+    || !server_write(fd, &srcLen, sizeof(srcLen))
+    || !server_write(fd, src, len)
+    || !server_read(fd, header, sizeof(header)))
+    return false;
+  *result = (int)ntohl(header[0]);
+  return server_readBuffer(fd, code, ntohl(header[1])) && server_readBuffer(fd, diagnostics, ntohl(header[2]));
+}
@@ -0,0 +1,69 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    server.h
+ * \brief   Compilation server on unix socket
+ *
+ * Server keeps compiler warm in one process and compiles programs sent by clients through unix
+ * socket. Connections are served by fixed pool of worker threads, every worker has its own compiler
+ * context and serves one connection at a time, further connections wait in backlog of socket until
+ * some worker is free. Requests of one connection are processed one after another. State of
+ * compilation is reset between requests by ifjc_compile (memory manager frees whole arena of
+ * compilation), errors of compilation are returned to client and server keeps running.
+ *
+ * Frames (all numbers are 32 bit unsigned in network byte order):
+ *   request:  length of source, source
+ *   response: error code, length of code, length of diagnostics, code, diagnostics
+ * Request with source longer than SERVER_MAX_SOURCE gets response with error code 99 and reason in
+ * diagnostics, then server closes connection.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _Server
+#define _Server
+
+#include <stdbool.h>
+#include "membuf.h"
+#include "cache.h"
+
+/**
+ * Maximal length of source code in one request
+ */
+#define SERVER_MAX_SOURCE (64u * 1024u * 1024u)
+
+/**
+ * Runs server, returns only if socket cannot be created
+ *
+ * \param socketPath path of unix socket, existing socket is replaced
+ * \param threadCnt count of worker threads (maximal count of served connections), 0 for count of online processors
+ * \param maxBuffer limit of code buffer of main scope in bytes (ifjc_setMaxBuffer), 0 for no limit
+ * \param cache cache of compiled programs shared by connections, NULL for no cache
+ * \returns error code (99)
+ */
+int server_run(const char *socketPath, unsigned threadCnt, unsigned maxBuffer, TCompileCache cache);
+
+/**
+ * Connects client to server
+ *
+ * \param socketPath path of unix socket
+ * \returns socket descriptor or -1 on error
+ */
+int server_connect(const char *socketPath);
+
+/**
+ * Compiles program on server (client side of one request)
+ *
+ * \param fd socket descriptor returned by server_connect
+ * \param src source code
+ * \param len length of source code
+ * \param code buffer for generated code, previous content is replaced
+ * \param diagnostics buffer for error messages, previous content is replaced
+ * \param result error code of compilation
+ * \returns false if communication with server failed
+ */
+bool server_compile(int fd, const char *src, unsigned len, TMemBuf *code, TMemBuf *diagnostics, int *result);
+
+#endif // _Server
@@ -28,6 +28,7 @@ void tknl_insertLast(TTkList list, SToken *token)
 {
   TTkListItem *item = mmng_safeMalloc(sizeof(TTkListItem));
   item->next = NULL;
+  item->prev = NULL;
   item->token = *token;
   if (list->last != NULL)
   {
@@ -0,0 +1,98 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    stats.c
+ * \brief   Counters of hot paths of compiler
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include "stats.h"
+#include "utils.h"
+
+#define STATS_MAX_LINE 256
+
+static const char *phaseNames[statsPhaseCnt] = { "init", "compile", "optimize", "link", "teardown" };
+
+// =============================================================================
+// ====================== support functions ====================================
+// =============================================================================
+
+// prints formatted part of report
+void stats_print(TIfjcOutput output, void *userData, const char *format, ...)
+{
+  char line[STATS_MAX_LINE];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(line, STATS_MAX_LINE, format, args);
+  va_end(args);
+  if (len > 0)
+    output(line, (len < STATS_MAX_LINE) ? (unsigned)len : STATS_MAX_LINE - 1, userData);
+}
+
+// prints name of token type as JSON string
+void stats_printTokenName(TIfjcOutput output, void *userData, EGrSymb type)
+{
+  const char *name = grammarToString(type);
+  output("\"", 1, userData);
+  for (; *name != '\0'; name++)
+  {
+    if (*name == '"' || *name == '\\')
+      output("\\", 1, userData);
+    output(name, 1, userData);
+  }
+  output("\"", 1, userData);
+}
+
+// =============================================================================
+// ====================== Interface implementation =============================
+// =============================================================================
+
+double stats_now()
+{
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+void stats_printJson(const TStats *stats, int result, TIfjcOutput output, void *userData)
+{
+  stats_print(output, userData, "{\n  \"version\": \"%s\",\n  \"result\": %d,\n  \"phases\": {", IFJC_VERSION, result);
+  for (int i = 0; i < statsPhaseCnt; i++)
+    stats_print(output, userData, "%s\n    \"%s\": %.6f", (i > 0) ? "," : "", phaseNames[i], stats->phases[i]);
+
+  stats_print(output, userData, "\n  },\n  \"counters\": {\n    \"symbolLookupsByDepth\": [");
+  for (int i = 0; i < STATS_MAX_DEPTH; i++)
+    stats_print(output, userData, "%s%llu", (i > 0) ? ", " : "", stats->lookups[i]);
+  stats_print(output, userData, "],\n    \"avlRotations\": { \"left\": %llu, \"right\": %llu },\n",
+    stats->rotationsLeft, stats->rotationsRight);
+  stats_print(output, userData, "    \"mmng\": { \"allocations\": %llu, \"reallocations\": %llu, \"frees\": %llu, "
+    "\"listWalkSteps\": %llu, \"listWalkMax\": %llu },\n",
+    stats->allocs, stats->reallocs, stats->frees, stats->listWalks, stats->listWalkMax);
+
+  stats_print(output, userData, "    \"tokens\": {");
+  bool isFirst = true;
+  for (int i = 0; i < STATS_TOKEN_TYPES; i++)
+  {
+    if (stats->tokens[i] == 0)
+      continue;
+    stats_print(output, userData, "%s\n      ", isFirst ? "" : ",");
+    stats_printTokenName(output, userData, (EGrSymb)i);
+    stats_print(output, userData, ": %llu", stats->tokens[i]);
+    isFirst = false;
+  }
+  stats_print(output, userData, "\n    },\n");
+
+  stats_print(output, userData, "    \"precedenceReductions\": %llu,\n", stats->reductions);
+  stats_print(output, userData, "    \"temps\": { \"requested\": %llu, \"slotsCreated\": %llu },\n",
+    stats->temps, stats->tempSlots);
+  stats_print(output, userData, "    \"emittedBytes\": %llu\n  }\n}\n", stats->emittedBytes);
+}
@@ -0,0 +1,101 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    stats.h
+ * \brief   Counters of hot paths of compiler
+ *
+ * Counters and wall times of phases of compilation are part of compiler context. They exist only
+ * in build with STATS defined (make stats), otherwise all macros of package are empty and compiler
+ * does not spend any instruction on them. Report of last compilation of context is printed as JSON
+ * by ifjc_printStats().
+ *
+ * Functions compiled in parallel by worker threads (see parallel.h) are counted in contexts of
+ * workers, so counters of parallel compilation contain only work of main thread.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#ifndef _Stats
+#define _Stats
+
+#include "ifjc.h"
+#include "grammar.h"
+
+#define STATS_MAX_DEPTH 8     // lookups in deeper frames are counted in the last item
+#define STATS_TOKEN_TYPES (kwStep + 1) // count of terminal symbols of grammar (tokens)
+
+/**
+ * Measured phases of compilation
+ */
+typedef enum {
+  statsInit,      /*!< initialization of modules */
+  statsCompile,   /*!< whole processing of source code, including following two phases */
+  statsOptimize,  /*!< optimizations of code of functions (control flow, copy propagation) */
+  statsLink,      /*!< inline expansion and printing of reachable code units */
+  statsTeardown,  /*!< destruction of modules and freeing of memory */
+  statsPhaseCnt
+} EStatsPhase;
+
+/**
+ * Counters of one compilation
+ */
+typedef struct {
+  unsigned long long lookups[STATS_MAX_DEPTH]; /*!< symbol lookups by count of searched frames */
+  unsigned long long rotationsLeft;   /*!< AVL rotations of symbol tables */
+  unsigned long long rotationsRight;
+  unsigned long long allocs;          /*!< allocations of memory manager */
+  unsigned long long reallocs;
+  unsigned long long frees;
+  unsigned long long listWalks;       /*!< items of list of pointers walked by memory manager */
+  unsigned long long listWalkMax;     /*!< longest walk of list of pointers */
+  unsigned long long tokens[STATS_TOKEN_TYPES]; /*!< tokens by type */
+  unsigned long long reductions;      /*!< reductions of precedence analysis */
+  unsigned long long temps;           /*!< auxiliary variables given to expressions */
+  unsigned long long tempSlots;       /*!< slots of auxiliary variables created */
+  unsigned long long emittedBytes;    /*!< bytes of code printed by instructions */
+  double phases[statsPhaseCnt];       /*!< wall times of phases in seconds */
+} TStats;
+
+#ifdef STATS
+
+#define STATS_INC(counter) (GLBCompilerCtx->stats.counter++)
+#define STATS_ADD(counter, value) (GLBCompilerCtx->stats.counter += (value))
+#define STATS_MAX(counter, value) \
+  do { if ((value) > GLBCompilerCtx->stats.counter) GLBCompilerCtx->stats.counter = (value); } while (0)
+#define STATS_LOOKUP(depth) STATS_INC(lookups[((depth) < STATS_MAX_DEPTH ? (depth) : STATS_MAX_DEPTH) - 1])
+#define STATS_WALK(steps) do { STATS_ADD(listWalks, steps); STATS_MAX(listWalkMax, steps); } while (0)
+#define STATS_BEGIN(start) double start = stats_now()
+#define STATS_END(phase, start) (GLBCompilerCtx->stats.phases[phase] += stats_now() - (start))
+
+#else
+
+#define STATS_INC(counter) ((void)0)
+#define STATS_ADD(counter, value) ((void)0)
+#define STATS_MAX(counter, value) ((void)0)
+#define STATS_LOOKUP(depth) ((void)0)
+#define STATS_WALK(steps) ((void)(steps))
+#define STATS_BEGIN(start) ((void)0)
+#define STATS_END(phase, start) ((void)0)
+
+#endif // STATS
+
+/**
+ * Actual wall time
+ *
+ * \returns monotonic time in seconds
+ */
+double stats_now();
+
+/**
+ * Prints counters as JSON object
+ *
+ * \param stats counters
+ * \param result error code of compilation
+ * \param output output of report
+ * \param userData user data passed to output
+ */
+void stats_printJson(const TStats *stats, int result, TIfjcOutput output, void *userData);
+
+#endif // _Stats
@@ -18,6 +18,7 @@
 #include "utils.h"
 #include "stacks.h"
 #include "symtable.h"
+#include "compilerctx.h"
 
 // =============================================================================
 // ================= Iternal data structures definition ========================
@@ -40,6 +41,7 @@ struct RedefSymb {
   TSymbol symbol;
   SymbolType origType;
   DataType origDataType;
+  char *origIdent;
 };
 
 // node of AVL tree main root with no parent reprezenting one symbol table
@@ -51,13 +53,14 @@ struct SymTable {
   bool isDoLoop;              // flag if frame is do...loop loop
   char *frameLabel;           // label of frame
   unsigned int localLabelCnt; // counter of local labels
+  unsigned int redefCnt;      // counter of redefined variables (unique identifiers in function)
   TPStack redefStack;         // stack of redefined symbols to be pops and frame end
   TPStack definedIdentVars;   // stact of defined variable identifiers
   unsigned int tmpCnt;        // counter of generated temporaly symbols
 };
 
-// global internal instance of symbol table stack
-TPStack GLBSymbTabStack;
+// internal instance of symbol table stack is part of actual compiler context
+#define GLBSymbTabStack (GLBCompilerCtx->symbTabStack)
 
 // =============================================================================
 // ====================== TRedefSymb implementation ==============================
@@ -70,6 +73,7 @@ TRedefSymb TRedefSymb_create(TSymbol symb)
   new->symbol = symb;
   new->origType = symb->type;
   new->origDataType = symb->dataType;
+  new->origIdent = symb->ident;
   return new;
 }
 
@@ -279,6 +283,7 @@ void TSTNode_rotateRight(TSTNode self)
 {
   if (self == NULL || self->left == NULL)
     return;
+  STATS_INC(rotationsRight);
 
   #ifdef ST_DEBUG
   fprintf(stderr, "RotRight: %s\n", self->key);
@@ -307,6 +312,7 @@ void TSTNode_rotateLeft(TSTNode self)
 {
   if (self == NULL || self->right == NULL)
     return;
+  STATS_INC(rotationsLeft);
 
   #ifdef ST_DEBUG
   fprintf(stderr, "RotLeft: %s\n", self->key);
@@ -553,6 +559,7 @@ TSymTable TSymTable_create(char *frameLabel, bool transparent, bool isForLoop, b
   newST->root = NULL;
   newST->frameLabel = util_StrHardCopy(frameLabel);
   newST->localLabelCnt = 0;
+  newST->redefCnt = 0;
   newST->isForLoop = isForLoop;
   newST->isDoLoop = isDoLoop;
   newST->redefStack = TPStack_create();
@@ -691,7 +698,6 @@ void symbt_pushFrame(char *label, bool transparent, bool isForLoop, bool isDoLoo
 {
   symbt_assertIfNotInit();
   deleteTempSymbols();
-  printInstruction("CREATEFRAME\n");
   GLBSymbTabStack->push(GLBSymbTabStack, TSymTable_create(label, transparent, isForLoop, isDoLoop));
 }
 
@@ -708,14 +714,17 @@ void symbt_popFrame()
       table->redefStack->pop(table->redefStack);
       redefSymb->symbol->type = redefSymb->origType;
       redefSymb->symbol->dataType = redefSymb->origDataType;
-      if (redefSymb->symbol->type == symtVariable)
-        printInstruction("POPS %s\n", redefSymb->symbol->ident);
+      if (redefSymb->symbol->ident != redefSymb->origIdent)
+      {
+        mmng_safeFree(redefSymb->symbol->ident);
+        redefSymb->symbol->ident = redefSymb->origIdent;
+      }
+      TRedefSymb_destroy(redefSymb);
     }
     if (!table->isTransparent)
       flushCode();
     GLBSymbTabStack->pop(GLBSymbTabStack);
     TSymTable_destroy(table);
-    printInstruction("CREATEFRAME\n");
     deleteTempSymbols();
   }
 }
@@ -734,6 +743,14 @@ int symbt_cntFuncFrames()
   return cnt;
 }
 
+// Checks if actual frame is top frame of main scope
+bool symbt_isMainScope()
+{
+  symbt_assertIfNotInit();
+  TSymTable table = GLBSymbTabStack->top(GLBSymbTabStack);
+  return GLBSymbTabStack->count == 2 && table->isTransparent;
+}
+
 // Finds symbol by indentifier
 TSymbol symbt_findSymb(char *ident)
 {
@@ -745,17 +762,26 @@ TSymbol symbt_findSymb(char *ident)
   TSymTable actTable = GLBSymbTabStack->top(GLBSymbTabStack);
   TSymbol foundSymb = TSymTable_find(actTable, ident);
   if (foundSymb != NULL)
+  {
+    STATS_LOOKUP(1);
     return foundSymb;
+  }
 
-  // searching from top until searched table is not transparent or next on stack is global
-  for (int i = GLBSymbTabStack->count - 2; i > 0 && actTable->isTransparent; i--)
+  // searching from top until searched table is not transparent or next on stack is global,
+  // count - i tables are searched when table i is searched
+  int i = GLBSymbTabStack->count - 2;
+  for (; i > 0 && actTable->isTransparent; i--)
   {
     actTable = GLBSymbTabStack->ptArray[i];
     foundSymb = TSymTable_find(actTable, ident);
     if (foundSymb != NULL)
+    {
+      STATS_LOOKUP(GLBSymbTabStack->count - i);
       return foundSymb;
+    }
   }
   // search global table
+  STATS_LOOKUP(GLBSymbTabStack->count - i);
   return TSymTable_find(GLBSymbTabStack->ptArray[0], ident);
 }
 
@@ -851,7 +877,7 @@ char *symbt_getNewLocalLabel()
   return cntString;
 }
 
-// Push value of variable symbol on datastack and remembers it for frame destroing
+// Renames variable symbol to unique identifier and remembers it for frame destroing
 bool symbt_pushRedefinition(TSymbol symbol)
 {
   symbt_assertIfNotInit();
@@ -866,7 +892,13 @@ bool symbt_pushRedefinition(TSymbol symbol)
     return false;
   actTable->redefStack->push(actTable->redefStack, TRedefSymb_create(symbol));
   if (symbol->type == symtVariable)
-    printInstruction("PUSHS %s\n", symbol->ident);
+  {
+    // every redefinition has own variable in local frame of function
+    TSymTable funcTable = getFirstNonTransparetFrame();
+    char *newIdent = mmng_safeMalloc(sizeof(char) * (strlen(symbol->ident) + 12));
+    sprintf(newIdent, "%s$%u", symbol->ident, funcTable->redefCnt++);
+    symbol->ident = newIdent;
+  }
   return true;
 }
 
@@ -153,7 +153,7 @@ void symbt_pushFrame(char *label, bool transparent, bool isForLoop, bool isDoLoo
 /**
  * Frees destroys symbol table on top of the stack.
  *
- * Also generates pops for every symbol which was redefined in frame
+ * Also restores original identifiers of every symbol which was redefined in frame
  * If the is only one table left to be poped,
  * it will be deleted and there is created new empty table insted of it
  */
@@ -166,6 +166,11 @@ void symbt_popFrame();
  */
 int symbt_cntFuncFrames();
 
+/**
+ * Checks if actual frame is top frame of main scope (statement is not nested in other statement)
+ */
+bool symbt_isMainScope();
+
 /**
  * Finds symbol by indentifier
  *
@@ -235,7 +240,10 @@ char *symbt_getActLocalLabel();
 char *symbt_getNewLocalLabel();
 
 /**
- * Redefines symbol on datastack and remembers it for frame destroying
+ * Redefines symbol in actual frame and remembers it for frame destroying
+ *
+ * Variable gets new identifier unique in function (ident$n), so it occupies its own slot of local frame
+ * while frame exists.
  * /returns bool FALSE when symbol is already refined on the same level
  */
 bool symbt_pushRedefinition(TSymbol symbol);
@@ -16,8 +16,10 @@
 #include "stacks.h"
 #include "apperr.h"
 #include "mmng.h"
+#include "constpool.h"
 #include "symtable.h"
 #include "exprsemanticanalyzer.h"
+#include "compilerctx.h"
 
 //=============================== DEBUG MACROS =========================================
 #ifdef PRECDEBUG
@@ -33,9 +35,79 @@
 #endif
 //======================================================================================
 
-TTkList tlist; //list used as stack in precedent analyze
-TPStack identStack; //list of free unused auxiliary variables
-unsigned nextTokenIdent; //for auxiliary variable generator
+// state of precedence analysis is part of actual compiler context
+#define tlist (GLBCompilerCtx->tlist) //list used as stack in precedent analyze
+#define tmpAlloc (*GLBCompilerCtx->tmpAllocator)
+#define condCtx (*GLBCompilerCtx->condContext)
+
+/**
+ * One slot of auxiliary variable TF@%T<index>
+ *
+ * Symbol of slot is not stored in symbol table, slot owns it.
+ */
+typedef struct TmpSlot *TTmpSlot;
+struct TmpSlot {
+  struct Symbol symbol; /*!< variable symbol of slot */
+  int index;            /*!< index of slot, number in identifier */
+  bool isLive;          /*!< true if value in slot is still used */
+  int level;            /*!< nest level of expression which owns live slot */
+};
+
+/**
+ * Allocator of auxiliary variables
+ *
+ * Free slots are kept in free list (stack of slot indexes) so getting and releasing slot is constant.
+ * Slots are released either explicitly when operand is consumed in expression or all at once
+ * on start of next expression of the same nest level (result of previous expression is dead then).
+ */
+struct TmpAllocator {
+  TTmpSlot *slots;      /*!< all slots ever created */
+  int slotCnt;          /*!< count of created slots */
+  int slotCap;          /*!< allocated size of slots and freeList */
+  int *freeList;        /*!< stack of indexes of free slots */
+  int freeCnt;          /*!< count of indexes in freeList */
+  int exprLevel;        /*!< nest level of actually processed expression, 0 outside of expression */
+  unsigned liveCnt;     /*!< count of actually live slots */
+  unsigned maxLiveCnt;  /*!< maximum of live slots since last reset */
+  unsigned usedCnt;     /*!< count of slots used by code since last reset (highest index + 1) */
+};
+
+#define TMP_SLOT_CHUNK 16
+#define INLINE_MAX_ARGS 2 // maximal count of parameters of build-in function with inline code
+
+/**
+ * Node of boolean skeleton of condition
+ *
+ * Operators and, or, not of condition are not evaluated into auxiliary variables. Tree of their
+ * operands is built instead and lowered into chain of conditional jumps on the end of condition.
+ * Leaf is operand which is not boolean operation, its code is already in code buffer and ends on codeEnd.
+ * Tokens of inner nodes refer to symbol of node, so node is found by symbol of operand.
+ */
+typedef struct CondNode *TCondNode;
+struct CondNode {
+  struct Symbol symbol; /*!< placeholder symbol of node used by tokens */
+  EGrSymb oper;         /*!< opBoolAnd, opBoolOr, opBoolNot or eol for leaf */
+  TCondNode left;       /*!< left operand (the only one of not) */
+  TCondNode right;      /*!< right operand */
+  TSymbol value;        /*!< symbol with value of leaf */
+  unsigned codeStart;   /*!< position in code buffer where code of node starts */
+  unsigned codeEnd;     /*!< position in code buffer where code of node ends */
+};
+
+/**
+ * Context of actually processed condition
+ */
+struct CondContext {
+  int level;            /*!< nest level of condition expression, 0 if no condition is processed */
+  TCondNode *nodes;     /*!< all nodes of actual condition */
+  int nodeCnt;          /*!< count of nodes */
+  int nodeCap;          /*!< allocated size of nodes */
+  unsigned *events;     /*!< stack of code positions of condition start and shifted boolean operators */
+  int eventCnt;         /*!< count of positions in events */
+  int eventCap;         /*!< allocated size of events */
+};
+
+#define COND_CHUNK 16
 
 /**
 * returns 1 if symbol is terminal, otherwise 0
@@ -45,13 +117,6 @@ int isTerminal(EGrSymb symb)
   return symb < 1000;
 }
 
-int isBoolResult(SToken *arg2)
-{
-  if (arg2->type == opEq || arg2->type == opGrt || arg2->type == opLes || arg2->type == opLessEq || arg2->type == opGrtEq || arg2->type == opNotEq)
-    return 1;
-  return 0;
-}
-
 /**
 * returns closest terminal to top of the stack (its acually list).
 \post Token with terminal in list is set as active item
@@ -77,62 +142,363 @@ SToken nextToken()
   return token;
 }
 
-//aux variable function
-void syntx_emptyVarStack()
+//aux variable function - finds slot of symbol, NULL if symbol is not auxiliary variable
+TTmpSlot syntx_findSlot(TSymbol symbol)
 {
-  while (identStack->count > 0)
+  for (int i = 0; i < tmpAlloc.slotCnt; i++)
+    if (&(tmpAlloc.slots[i]->symbol) == symbol)
+      return tmpAlloc.slots[i];
+  return NULL;
+}
+
+//aux variable function - returns slot to free list
+void syntx_releaseSlot(int index)
+{
+  TTmpSlot slot = tmpAlloc.slots[index];
+  if (!slot->isLive)
+    return;
+  slot->isLive = false;
+  slot->symbol.dataType = dtUnspecified;
+  tmpAlloc.freeList[tmpAlloc.freeCnt++] = index;
+  tmpAlloc.liveCnt--;
+}
+
+//aux variable function - releases all slots owned by expressions of given level or deeper
+void syntx_releaseLevel(int level)
+{
+  for (int i = tmpAlloc.slotCnt - 1; i >= 0; i--)
+    if (tmpAlloc.slots[i]->isLive && tmpAlloc.slots[i]->level >= level)
+      syntx_releaseSlot(i);
+}
+
+//aux variable function - creates new slot and puts it into free list
+void syntx_createSlot()
+{
+  if (tmpAlloc.slotCnt == tmpAlloc.slotCap)
   {
-    ((TSymbol)identStack->top(identStack))->dataType = dtUnspecified;
-    identStack->pop(identStack);
+    tmpAlloc.slotCap += TMP_SLOT_CHUNK;
+    tmpAlloc.slots = mmng_safeRealloc(tmpAlloc.slots, sizeof(TTmpSlot) * tmpAlloc.slotCap);
+    tmpAlloc.freeList = mmng_safeRealloc(tmpAlloc.freeList, sizeof(int) * tmpAlloc.slotCap);
   }
+  TTmpSlot slot = mmng_safeMalloc(sizeof(struct TmpSlot));
+  slot->symbol.ident = mmng_safeMalloc(sizeof(char) * 16); // TF@%T + 10 digits + \0
+  sprintf(slot->symbol.ident, "TF@%%T%d", tmpAlloc.slotCnt);
+  slot->symbol.key = slot->symbol.ident + 3;
+  slot->symbol.type = symtVariable;
+  slot->symbol.dataType = dtUnspecified;
+  slot->symbol.isTemp = true;
+  slot->index = tmpAlloc.slotCnt;
+  slot->isLive = false;
+  slot->level = 0;
+  tmpAlloc.slots[tmpAlloc.slotCnt] = slot;
+  tmpAlloc.freeList[tmpAlloc.freeCnt++] = tmpAlloc.slotCnt;
+  tmpAlloc.slotCnt++;
+  STATS_INC(tempSlots);
 }
 
 //aux variable function
 void syntx_freeVar(SToken *var)
 {
-  var->symbol->dataType = dtUnspecified;
-  identStack->push(identStack, var->symbol);
+  TTmpSlot slot = syntx_findSlot(var->symbol);
+  if (slot != NULL)
+    syntx_releaseSlot(slot->index);
 }
 
 //aux variable function
 SToken sytx_getFreeVar()
 {
+  if (tmpAlloc.freeCnt == 0)
+    syntx_createSlot();
+  TTmpSlot slot = tmpAlloc.slots[tmpAlloc.freeList[--tmpAlloc.freeCnt]];
+  slot->isLive = true;
+  slot->level = (tmpAlloc.exprLevel > 0) ? tmpAlloc.exprLevel : 1; // used after expression as its part
+  slot->symbol.dataType = dtUnspecified;
+  // slots are defined once in prologue of function
+  if ((unsigned)slot->index >= tmpAlloc.usedCnt && !util_isDeadCode())
+    tmpAlloc.usedCnt = slot->index + 1;
+  tmpAlloc.liveCnt++;
+  STATS_INC(temps);
+  if (tmpAlloc.liveCnt > tmpAlloc.maxLiveCnt)
+    tmpAlloc.maxLiveCnt = tmpAlloc.liveCnt;
+
   SToken token;
   token.type = NT_EXPR_TMP;
-  //if stack not empty, return ident from stack
-  if(identStack->count != 0)
+  token.dataType = dtUnspecified;
+  token.symbol = &(slot->symbol);
+  return token;
+}
+
+// Maximal count of simultaneously live auxiliary variables since last reset
+unsigned syntx_getMaxLiveTemps()
+{
+  return tmpAlloc.maxLiveCnt;
+}
+
+// Resets counter of maximal count of live auxiliary variables (on start of function)
+void syntx_resetMaxLiveTemps()
+{
+  tmpAlloc.maxLiveCnt = tmpAlloc.liveCnt;
+}
+
+// Count of auxiliary variables used since last reset
+unsigned syntx_getUsedTemps()
+{
+  return tmpAlloc.usedCnt;
+}
+
+// Resets count of used auxiliary variables (on start of function)
+void syntx_resetUsedTemps()
+{
+  tmpAlloc.usedCnt = 0;
+  // no expression is processed between functions, all slots are free and they are taken from
+  // the lowest index, so auxiliary variables of function do not depend on previous function
+  tmpAlloc.freeCnt = 0;
+  for (int i = tmpAlloc.slotCnt - 1; i >= 0; i--)
+  {
+    tmpAlloc.slots[i]->isLive = false;
+    tmpAlloc.slots[i]->symbol.dataType = dtUnspecified;
+    tmpAlloc.freeList[tmpAlloc.freeCnt++] = i;
+  }
+  tmpAlloc.liveCnt = 0;
+}
+
+//condition function - true if boolean operators of actual expression are lowered into jumps
+bool syntx_isCondLevel()
+{
+  return condCtx.level != 0 && condCtx.level == tmpAlloc.exprLevel;
+}
+
+//condition function - pushes code position of start of condition or shifted boolean operator
+void syntx_condPushEvent(unsigned position)
+{
+  if (condCtx.eventCnt == condCtx.eventCap)
+  {
+    condCtx.eventCap += COND_CHUNK;
+    condCtx.events = mmng_safeRealloc(condCtx.events, sizeof(unsigned) * condCtx.eventCap);
+  }
+  condCtx.events[condCtx.eventCnt++] = position;
+}
+
+//condition function - pops position of reduced boolean operator
+unsigned syntx_condPopEvent()
+{
+  if (condCtx.eventCnt <= 1)
+    apperr_runtimeError("SyntaxAnalyzer.c: condition operator without position!");
+  return condCtx.events[--condCtx.eventCnt];
+}
+
+//condition function - finds node of symbol, NULL if symbol is not boolean skeleton node
+TCondNode syntx_condFindNode(TSymbol symbol)
+{
+  for (int i = 0; i < condCtx.nodeCnt; i++)
+    if (&(condCtx.nodes[i]->symbol) == symbol)
+      return condCtx.nodes[i];
+  return NULL;
+}
+
+//condition function - creates new node
+TCondNode syntx_condNewNode(EGrSymb oper, TCondNode left, TCondNode right)
+{
+  if (condCtx.nodeCnt == condCtx.nodeCap)
+  {
+    condCtx.nodeCap += COND_CHUNK;
+    condCtx.nodes = mmng_safeRealloc(condCtx.nodes, sizeof(TCondNode) * condCtx.nodeCap);
+  }
+  TCondNode node = mmng_safeMalloc(sizeof(struct CondNode));
+  node->symbol.ident = NULL;
+  node->symbol.key = NULL;
+  node->symbol.type = symtVariable;
+  node->symbol.dataType = dtBool;
+  node->symbol.isTemp = true;
+  node->oper = oper;
+  node->left = left;
+  node->right = right;
+  node->value = NULL;
+  node->codeStart = (left != NULL) ? left->codeStart : 0;
+  node->codeEnd = (right != NULL) ? right->codeEnd : ((left != NULL) ? left->codeEnd : 0);
+  condCtx.nodes[condCtx.nodeCnt++] = node;
+  return node;
+}
+
+//condition function - node of operand, leaf is created for operand which is not boolean operation
+TCondNode syntx_condOperand(SToken *operand, unsigned codeStart, unsigned codeEnd)
+{
+  TCondNode node = syntx_condFindNode(operand->symbol);
+  if (node != NULL)
+    return node;
+  if (operand->symbol->dataType != dtBool)
+    scan_raiseCodeError(typeCompatibilityErr, "One or both operands do not have boolean type.", NULL);
+  node = syntx_condNewNode(eol, NULL, NULL);
+  node->value = operand->symbol;
+  node->codeStart = codeStart;
+  node->codeEnd = codeEnd;
+  return node;
+}
+
+//condition function - frees all nodes of condition
+void syntx_condFreeNodes()
+{
+  for (int i = 0; i < condCtx.nodeCnt; i++)
+    mmng_safeFree(condCtx.nodes[i]);
+  condCtx.nodeCnt = 0;
+}
+
+//condition function - reprints code from cursor up to position
+void syntx_condPrintCode(const char *code, unsigned base, unsigned *cursor, unsigned end)
+{
+  if (end > *cursor)
+  {
+    unsigned len = end - *cursor;
+    printLongInstruction(len, "%.*s", (int)len, &code[*cursor - base]);
+    *cursor = end;
+  }
+}
+
+//condition function - reprints code of node and evaluates it into auxiliary variable
+SToken syntx_condMaterialize(TCondNode node, const char *code, unsigned base, unsigned *cursor)
+{
+  SToken result;
+  if (node->oper == eol)
+  {
+    syntx_condPrintCode(code, base, cursor, node->codeEnd);
+    result.type = NT_EXPR;
+    result.dataType = dtBool;
+    result.symbol = node->value;
+    return result;
+  }
+  SToken oper;
+  oper.type = node->oper;
+  SToken left = syntx_condMaterialize(node->left, code, base, cursor);
+  if (node->oper == opBoolNot)
+  {
+    result = sytx_getFreeVar();
+    syntx_generateCode(&left, &oper, NULL, &result);
+  }
+  else
+  {
+    SToken right = syntx_condMaterialize(node->right, code, base, cursor);
+    result = sytx_getFreeVar();
+    syntx_generateCode(&left, &oper, &right, &result);
+  }
+  return result;
+}
+
+/**
+ * Replaces boolean skeleton node in operand by auxiliary variable with its value.
+ * Used when result of and, or, not is operand of another operation in condition (e.g. (a and b) = c).
+ * Code of all operands of node is reprinted and original non short-circuit operations are generated.
+ */
+void syntx_condMaterializeOperand(SToken *operand)
+{
+  if (operand == NULL || condCtx.nodeCnt == 0)
+    return;
+  TCondNode node = syntx_condFindNode(operand->symbol);
+  if (node == NULL)
+    return;
+  unsigned base = node->codeStart;
+  unsigned cursor = base;
+  char *code = util_cutCode(base);
+  *operand = syntx_condMaterialize(node, code, base, &cursor);
+  // code following node (e.g. second operand) stays after it
+  unsigned len = strlen(code) - (cursor - base);
+  if (len > 0)
+    printLongInstruction(len, "%s", &code[cursor - base]);
+  mmng_safeFree(code);
+}
+
+//condition function - prints code of leaf followed by jump to label if leaf value is equal to jumpIfTrue
+void syntx_condJumpLeaf(TCondNode leaf, const char *label, bool jumpIfTrue, const char *code, unsigned base, unsigned *cursor)
+{
+  unsigned start = *cursor;
+  unsigned end = leaf->codeEnd;
+  TSymbol value = leaf->value;
+  if (value->type == symtConstant)
   {
-    token.symbol = (TSymbol)identStack->top(identStack);
-    identStack->pop(identStack);
-    return token;
+    syntx_condPrintCode(code, base, cursor, end);
+    if (value->data.boolVal == jumpIfTrue)
+      printInstruction("JUMP %s\n", label);
+    return;
   }
-  while(1)
+
+  // result of last comparison is not needed in auxiliary variable, negations are replaced
+  // by opposite jump and equality is compared directly by jump instruction
+  char *eqOperands = NULL;
+  if (value->isTemp && value->ident != NULL)
   {
-    if (nextTokenIdent == 1000000) //is that enough?
+    size_t identLen = strlen(value->ident);
+    bool isChanged = true;
+    while (isChanged && end > start)
     {
-      apperr_runtimeError("syntx_getFreeVar(): Limit of auxiliary variables reached! Too complicated expression.");
+      isChanged = false;
+      // beginning of last line
+      unsigned lineStart = end - 1;
+      while (lineStart > start && code[lineStart - 1 - base] != '\n')
+        lineStart--;
+      const char *line = &code[lineStart - base];
+      unsigned lineLen = end - lineStart;
+      if (strncmp(line, "NOT ", 4) == 0 && lineLen == 4 + identLen * 2 + 2 &&
+          strncmp(&line[4], value->ident, identLen) == 0 && line[4 + identLen] == ' ' &&
+          strncmp(&line[5 + identLen], value->ident, identLen) == 0)
+      {
+        jumpIfTrue = !jumpIfTrue;
+        end = lineStart;
+        isChanged = true;
+      }
+      else if (strncmp(line, "EQ ", 3) == 0 && lineLen > 4 + identLen &&
+          strncmp(&line[3], value->ident, identLen) == 0 && line[3 + identLen] == ' ')
+      {
+        unsigned opLen = lineLen - 4 - identLen - 1; // without new line
+        eqOperands = mmng_safeMalloc(sizeof(char) * (opLen + 1));
+        memcpy(eqOperands, &line[4 + identLen], opLen);
+        eqOperands[opLen] = '\0';
+        end = lineStart;
+      }
     }
-    //generate next ident
-    char *ident = mmng_safeMalloc(sizeof(char) * 12); // TF@%T[1-9][0-9]{0,5}EOL = 12
-    sprintf(ident, "TF@%%T%d", nextTokenIdent);
-    nextTokenIdent++;
-    //if not defined, define ident
-    token.symbol = symbt_findSymb(ident);
-    if (token.symbol == NULL)
-    {
-      token.symbol = symbt_insertSymbOnTop(ident);
-      token.symbol->isTemp = true; // mark symbol as temporaly (deleted on changing frame)
-      token.symbol->type = symtVariable;
-      token.symbol->dataType = dtUnspecified;
-      printInstruction("DEFVAR %s\n", ident);
+  }
+
+  syntx_condPrintCode(code, base, cursor, end);
+  *cursor = leaf->codeEnd;
+  if (eqOperands != NULL)
+  {
+    printLongInstruction(strlen(eqOperands), "%s %s %s\n", jumpIfTrue ? "JUMPIFEQ" : "JUMPIFNEQ", label, eqOperands);
+    mmng_safeFree(eqOperands);
+  }
+  else
+    printInstruction("%s %s %s bool@true\n", jumpIfTrue ? "JUMPIFEQ" : "JUMPIFNEQ", label, value->ident);
+}
+
+/**
+ * Prints code of node which jumps to label if value of node is equal to jumpIfTrue, otherwise continues.
+ * Right operand of and/or is skipped when value is decided by left operand.
+ */
+void syntx_condJump(TCondNode node, const char *label, bool jumpIfTrue, const char *code, unsigned base, unsigned *cursor)
+{
+  switch (node->oper)
+  {
+    case opBoolNot:
+      syntx_condJump(node->left, label, !jumpIfTrue, code, base, cursor);
       break;
-    }else if(token.symbol->dataType == dtUnspecified){
-      //already free
+    case opBoolAnd:
+    case opBoolOr:
+      // "a and b" jumps on false and "a or b" on true right after left operand
+      if ((node->oper == opBoolAnd) != jumpIfTrue)
+      {
+        syntx_condJump(node->left, label, jumpIfTrue, code, base, cursor);
+        syntx_condJump(node->right, label, jumpIfTrue, code, base, cursor);
+      }
+      else
+      {
+        char *skipLabel = symbt_getNewLocalLabel();
+        syntx_condJump(node->left, skipLabel, !jumpIfTrue, code, base, cursor);
+        syntx_condJump(node->right, label, jumpIfTrue, code, base, cursor);
+        printInstruction("LABEL %s\n", skipLabel);
+        mmng_safeFree(skipLabel);
+      }
       break;
-    }
-    mmng_safeFree(ident);
-}
-  return token;
+    default:
+      syntx_condJumpLeaf(node, label, jumpIfTrue, code, base, cursor);
+      break;
+  }
 }
 
 /* Use syntax rule at the end of the list. If there is no valid combination, returns zero. */
@@ -168,24 +534,40 @@ int syntx_useRule(TTkList list)
     //symbt_printSymb(arg1->symbol);
     //fprintf(stderr, "op: %d\n", arg2->type);
     //symbt_printSymb(arg3->symbol);
+    bool isCondOp = syntx_isCondLevel() && (arg2->type == opBoolAnd || arg2->type == opBoolOr);
+    unsigned operPos = 0;
+    if (isCondOp)
+      operPos = syntx_condPopEvent();
+    else
+    {
+      // value of and/or/not of condition is needed (right operand first, its code is last)
+      syntx_condMaterializeOperand(arg3);
+      syntx_condMaterializeOperand(arg1);
+    }
     if (arg1->symbol->type == symtConstant && arg3->symbol->type == symtConstant)
     {
-      if (isBoolResult(arg2))
-      {
-        ret_var = sytx_getFreeVar();
-        syntx_generateCode(arg1, arg2, arg3, &ret_var);
-        list->postInsert(list, &ret_var);
-      }
-      else
-      {
-        SToken t = syntx_doArithmeticOp(arg1, arg2, arg3);
-        list->postInsert(list, &t);
-      }
+      // operation with constants is evaluated in compile time
+      SToken t = syntx_doArithmeticOp(arg1, arg2, arg3);
+      list->postInsert(list, &t);
       list->next(list);
       list->preDelete(list);
       list->postDelete(list);
       list->postDelete(list);
     }
+    else if (isCondOp)
+    {
+      // operation is not evaluated, it becomes node of condition jump chain
+      TCondNode left = syntx_condOperand(arg1, condCtx.events[condCtx.eventCnt - 1], operPos);
+      TCondNode right = syntx_condOperand(arg3, operPos, util_codePosition());
+      ret_var.type = NT_EXPR;
+      ret_var.dataType = dtBool;
+      ret_var.symbol = &(syntx_condNewNode(arg2->type, left, right)->symbol);
+      list->postDelete(list);
+      list->postDelete(list);
+      list->postInsert(list, &ret_var);
+      list->next(list);
+      list->preDelete(list);
+    }
     else if(arg1->type == NT_EXPR_TMP && arg3->type == NT_EXPR_TMP){
       syntx_generateCode(arg1, arg2, arg3, arg1);
       syntx_freeVar(arg3);
@@ -218,8 +600,30 @@ int syntx_useRule(TTkList list)
     DPRINT("Using rule EXPR --> kwNot EXPR");
     if (list->active->next == NULL)
       return 0;
-    ret_var = sytx_getFreeVar();
-    syntx_generateCode(&list->active->next->token, &list->active->token, NULL, &ret_var);
+    if (syntx_isCondLevel())
+    {
+      unsigned operPos = syntx_condPopEvent();
+      if (list->active->next->token.symbol->type != symtConstant)
+      {
+        // negation in condition only swaps targets of jumps
+        TCondNode operand = syntx_condOperand(&list->active->next->token, operPos, util_codePosition());
+        ret_var.type = NT_EXPR;
+        ret_var.dataType = dtBool;
+        ret_var.symbol = &(syntx_condNewNode(opBoolNot, operand, NULL)->symbol);
+        list->postDelete(list);
+        list->postInsert(list, &ret_var);
+        list->next(list);
+        list->preDelete(list);
+        break;
+      }
+    }
+    if (list->active->next->token.symbol->type == symtConstant)
+      ret_var = syntx_doArithmeticOp(&list->active->next->token, &list->active->token, NULL);
+    else
+    {
+      ret_var = sytx_getFreeVar();
+      syntx_generateCode(&list->active->next->token, &list->active->token, NULL, &ret_var);
+    }
     list->postDelete(list);
     list->postInsert(list, &ret_var);
     list->next(list);
@@ -240,6 +644,7 @@ int syntx_useRule(TTkList list)
       return 0;
     if (list->active->next->token.symbol == NULL)
       return 0;
+    syntx_condMaterializeOperand(&list->active->next->token);
     if(list->active->next->token.symbol->type == symtConstant)
     {
       ret_var = syntx_doUnaryMinus(&list->active->next->token);
@@ -247,13 +652,7 @@ int syntx_useRule(TTkList list)
       ret_var = sytx_getFreeVar();
       SToken zeroT;
       zeroT.type = ident;
-      zeroT.symbol = symbt_findOrInsertSymb("0");
-      if(zeroT.symbol->type == symtUnknown)
-      {
-        zeroT.symbol->type = symtConstant;
-        zeroT.symbol->dataType = dtInt;
-        zeroT.symbol->data.intVal = 0;
-      }
+      zeroT.symbol = cpool_int(0);
       syntx_generateCode(&zeroT, &list->active->token, &list->active->next->token, &ret_var);
     }
     list->postDelete(list);
@@ -284,6 +683,7 @@ int syntx_useRule(TTkList list)
 
   //delete <
   list->preDelete(list);
+  STATS_INC(reductions);
   DPRINT("+++ leaving useRule()");
   return 1;
 }
@@ -333,6 +733,9 @@ SToken syntx_parseFunction(SToken *actToken)
   if (actToken->type != opLeftBrc)
     scan_raiseCodeError(semanticErr, "Missing '(' after function identifier.", actToken);
   int argNum = 0;
+  // build-in functions with inline code need values of arguments, not data stack
+  bool isInline = syntx_isInlineFunc(&funcToken);
+  SToken inlineArgs[INLINE_MAX_ARGS];
   while (actToken->type != opRightBrc)
   {
     *actToken = nextToken();
@@ -349,10 +752,31 @@ SToken syntx_parseFunction(SToken *actToken)
     {
       scan_raiseCodeError(syntaxErr, "Function call isn't end with ')'.", actToken);
     }
-    syntx_generateCodeForVarDef(&funcToken, argNum, &argToken);
+    if (isInline)
+    {
+      syntx_checkArgument(&funcToken, argNum, &argToken);
+      //value of argument is used after next arguments, its variable belongs to calling expression
+      TTmpSlot slot = syntx_findSlot(argToken.symbol);
+      if (slot != NULL)
+        slot->level = (tmpAlloc.exprLevel > 0) ? tmpAlloc.exprLevel : 1;
+      inlineArgs[argNum] = argToken;
+    }
+    else
+    {
+      syntx_generateCodeForVarDef(&funcToken, argNum, &argToken);
+      //argument is on data stack, its auxiliary variables are free
+      syntx_releaseLevel(tmpAlloc.exprLevel + 1);
+    }
     argNum++;
   }
   SToken returnVal;
+  if (isInline)
+  {
+    returnVal = syntx_generateCodeForInlineFunc(&funcToken, argNum, inlineArgs);
+    for (int i = 0; i < argNum; i++)
+      syntx_freeVar(&inlineArgs[i]);
+    return returnVal;
+  }
   returnVal = sytx_getFreeVar();
   syntx_generateCodeForCallFunc(&funcToken, argNum, &returnVal);
   return returnVal;
@@ -445,6 +869,10 @@ void syntx_tableLogic(TTkList list, EGrSymb terminal, SToken *actToken)
     break;
   case precLes:
   {
+    // code of left operand of boolean operator in condition ends here
+    if (syntx_isCondLevel() &&
+        (actToken->type == opBoolAnd || actToken->type == opBoolOr || actToken->type == opBoolNot))
+      syntx_condPushEvent(util_codePosition());
     SToken auxToken;
     auxToken.type = precLes;
     list->postInsert(list, &auxToken);
@@ -474,7 +902,9 @@ TSymbol syntx_processExpression(SToken *actToken, TSymbol symbol)
     apperr_runtimeError("syntx_processExpression(): Modul not initialized. Call syntx_init() first!");
   if (!isExpressionType(actToken->type))
     scan_raiseCodeError(syntaxErr, "Symbol is not an expression.", actToken);
-  nextTokenIdent = 0; //reset identificator generator
+  //auxiliary variables of previous expression on this level are not needed anymore
+  syntx_releaseLevel(tmpAlloc.exprLevel + 1);
+  tmpAlloc.exprLevel++;
   EGrSymb terminal = syntx_getFirstTerminal(tlist);
   while (1)
   {
@@ -519,8 +949,7 @@ TSymbol syntx_processExpression(SToken *actToken, TSymbol symbol)
     scan_raiseCodeError(syntaxErr, "Incomplete expression.", NULL);
   }
 
-  //free ident stack
-  syntx_emptyVarStack();
+  tmpAlloc.exprLevel--;
 
   //return result
   SToken resultToken = tlist->last->token;
@@ -536,7 +965,7 @@ TSymbol syntx_processExpression(SToken *actToken, TSymbol symbol)
   else {
     //mov result from temporary variable to requested variable
     SToken retT;
-    retT.dataType = NT_EXPR;
+    retT.type = NT_EXPR;
     retT.symbol = symbol;
     SToken asgnT;
     asgnT.type = asgn;
@@ -548,10 +977,66 @@ TSymbol syntx_processExpression(SToken *actToken, TSymbol symbol)
   }
 }
 
+/**
+* Precedent analyze of condition lowered into conditional jumps
+*/
+TSymbol syntx_processCondition(SToken *actToken, const char *label, bool jumpIfTrue)
+{
+  if (condCtx.level != 0)
+    apperr_runtimeError("syntx_processCondition(): Nested condition!");
+  unsigned base = util_codePosition();
+  condCtx.level = tmpAlloc.exprLevel + 1;
+  condCtx.eventCnt = 0;
+  syntx_condPushEvent(base);
+  TSymbol result = syntx_processExpression(actToken, NULL);
+  condCtx.level = 0;
+
+  TCondNode root = syntx_condFindNode(result);
+  if (root == NULL)
+  {
+    if (result->dataType != dtBool)
+      scan_raiseCodeError(typeCompatibilityErr, "Condition expression does not return boolean value.", actToken);
+    if (result->type == symtConstant)
+    {
+      // condition evaluated in compile time
+      syntx_condFreeNodes();
+      return result;
+    }
+    root = syntx_condNewNode(eol, NULL, NULL);
+    root->value = result;
+    root->codeStart = base;
+    root->codeEnd = util_codePosition();
+  }
+
+  char *code = util_cutCode(base);
+  unsigned cursor = base;
+  syntx_condJump(root, label, jumpIfTrue, code, base, &cursor);
+  mmng_safeFree(code);
+  syntx_condFreeNodes();
+  return NULL;
+}
+
 void syntx_init()
 {
   tlist = TTkList_create();
-  identStack = TPStack_create();
+  GLBCompilerCtx->tmpAllocator = mmng_safeMalloc(sizeof(struct TmpAllocator));
+  GLBCompilerCtx->condContext = mmng_safeMalloc(sizeof(struct CondContext));
+  tmpAlloc.slots = NULL;
+  tmpAlloc.slotCnt = 0;
+  tmpAlloc.slotCap = 0;
+  tmpAlloc.freeList = NULL;
+  tmpAlloc.freeCnt = 0;
+  tmpAlloc.exprLevel = 0;
+  tmpAlloc.liveCnt = 0;
+  tmpAlloc.maxLiveCnt = 0;
+  tmpAlloc.usedCnt = 0;
+  condCtx.level = 0;
+  condCtx.nodes = NULL;
+  condCtx.nodeCnt = 0;
+  condCtx.nodeCap = 0;
+  condCtx.events = NULL;
+  condCtx.eventCnt = 0;
+  condCtx.eventCap = 0;
   SToken auxToken;
   auxToken.type = eol;
   tlist->insertLast(tlist, &auxToken);
@@ -562,7 +1047,31 @@ void syntx_destroy()
 {
   tlist->deleteLast(tlist);
   tlist->destroy(tlist);
-  while (identStack->count > 0)
-    identStack->pop(identStack);
-  identStack->destroy(identStack);
+  for (int i = 0; i < tmpAlloc.slotCnt; i++)
+  {
+    mmng_safeFree(tmpAlloc.slots[i]->symbol.ident);
+    mmng_safeFree(tmpAlloc.slots[i]);
+  }
+  if (tmpAlloc.slots != NULL)
+  {
+    mmng_safeFree(tmpAlloc.slots);
+    mmng_safeFree(tmpAlloc.freeList);
+  }
+  tmpAlloc.slots = NULL;
+  tmpAlloc.freeList = NULL;
+  tmpAlloc.slotCnt = 0;
+  tmpAlloc.slotCap = 0;
+  syntx_condFreeNodes();
+  if (condCtx.nodes != NULL)
+    mmng_safeFree(condCtx.nodes);
+  if (condCtx.events != NULL)
+    mmng_safeFree(condCtx.events);
+  condCtx.nodes = NULL;
+  condCtx.events = NULL;
+  condCtx.nodeCap = 0;
+  condCtx.eventCap = 0;
+  mmng_safeFree(GLBCompilerCtx->tmpAllocator);
+  mmng_safeFree(GLBCompilerCtx->condContext);
+  GLBCompilerCtx->tmpAllocator = NULL;
+  GLBCompilerCtx->condContext = NULL;
 }
\ No newline at end of file
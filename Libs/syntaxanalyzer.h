@@ -28,6 +28,27 @@ SToken sytx_getFreeVar();
 */
 void syntx_freeVar(SToken *var);
 
+/**
+ * Maximal count of simultaneously live auxiliary variables since last reset.
+ */
+unsigned syntx_getMaxLiveTemps();
+
+/**
+ * Resets counter of maximal count of live auxiliary variables, called on start of every function.
+ */
+void syntx_resetMaxLiveTemps();
+
+/**
+ * Count of auxiliary variables used by code since last reset, they have to be defined (DEFVAR)
+ * in temporary frame created in prologue of function.
+ */
+unsigned syntx_getUsedTemps();
+
+/**
+ * Resets count of used auxiliary variables, called on start of every function.
+ */
+void syntx_resetUsedTemps();
+
 /**
  * Start precedent analyze of epression.
  * \param actToken is first token of expression
@@ -36,6 +57,16 @@ void syntx_freeVar(SToken *var);
  */
 TSymbol syntx_processExpression(SToken *actToken, TSymbol symbol);
 
+/**
+ * Precedent analyze of condition of if, elseif or do loop.
+ * Condition is lowered into chain of conditional jumps, operators and, or are short-circuit
+ * (right operand is not evaluated when result is decided by left one) and values of and, or, not are not stored.
+ * \param actToken is first token of condition
+ * \param label is label where code jumps if condition has value jumpIfTrue, otherwise code continues
+ * \return Constant symbol if condition was evaluated in compile time (no code is generated), otherwise NULL.
+ */
+TSymbol syntx_processCondition(SToken *actToken, const char *label, bool jumpIfTrue);
+
 /**
  * Initialize precedent analyzer module. 
  */
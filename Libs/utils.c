@@ -13,14 +13,145 @@
 #include <string.h>
 #include "mmng.h"
 #include "utils.h"
+#include "cfg.h"
+#include "inliner.h"
+#include "copyprop.h"
+#include "apperr.h"
+#include "compilerctx.h"
 #include <stdarg.h>
 
 #define UTILS_ARR_CHUNK 1000
 
-unsigned arrPos = 0;
-char *Iarr;
-unsigned arrSize;
-bool lastWasCreateFrame = false;
+// code buffer is part of actual compiler context
+#define arrPos (GLBCompilerCtx->arrPos)
+#define Iarr (GLBCompilerCtx->Iarr)
+#define arrSize (GLBCompilerCtx->arrSize)
+#define lastWasCreateFrame (GLBCompilerCtx->lastWasCreateFrame)
+#define deadCodeLevel (GLBCompilerCtx->deadCodeLevel) // when non-zero, printed code is unreachable and it is thrown away
+
+/**
+ * Unit of output code, code of one function
+ *
+ * Units are printed on the end of compilation and only units reachable
+ * from entry unit by CALL instructions are printed.
+ */
+typedef struct CodeUnit *TCodeUnit;
+struct CodeUnit {
+  char *label;    /*!< label of function, NULL for unit which is printed always */
+  char *code;     /*!< code of unit */
+  unsigned len;   /*!< length of code */
+  unsigned cap;   /*!< allocated size of code */
+  bool isCalled;  /*!< unit is reachable from entry */
+  int inlineState; /*!< 0 - calls not expanded yet, 1 - expanding, 2 - expanded */
+};
+
+// units are part of actual compiler context
+#define codeUnits (GLBCompilerCtx->codeUnits)
+#define unitCnt (GLBCompilerCtx->unitCnt)
+#define unitCap (GLBCompilerCtx->unitCap)
+
+// state of streamed main function
+#define maxBuffer (GLBCompilerCtx->maxBuffer)
+#define streamedCnt (GLBCompilerCtx->streamedCnt)
+#define streamedTemps (GLBCompilerCtx->streamedTemps)
+#define streamedVars (GLBCompilerCtx->streamedVars)
+
+// appends code to unit
+void util_appendCode(TCodeUnit unit, const char *code, unsigned len)
+{
+  while (unit->len + len + 1 > unit->cap)
+  {
+    unit->cap += UTILS_ARR_CHUNK;
+    unit->code = mmng_safeRealloc(unit->code, sizeof(char) * unit->cap);
+  }
+  memcpy(&unit->code[unit->len], code, len);
+  unit->len += len;
+  unit->code[unit->len] = '\0';
+}
+
+// appends code to actual unit
+void util_appendToUnit(const char *code, unsigned len)
+{
+  if (unitCnt == 0)
+    util_beginCodeUnit(NULL);
+  util_appendCode(codeUnits[unitCnt - 1], code, len);
+}
+
+// finds unit by label
+TCodeUnit util_findUnit(const char *label, unsigned len)
+{
+  for (unsigned i = 0; i < unitCnt; i++)
+    if (codeUnits[i]->label != NULL && strlen(codeUnits[i]->label) == len &&
+        strncmp(codeUnits[i]->label, label, len) == 0)
+      return codeUnits[i];
+  return NULL;
+}
+
+// marks unit and all units called from it as called
+void util_markCalledUnits(TCodeUnit unit)
+{
+  if (unit == NULL || unit->isCalled)
+    return;
+  unit->isCalled = true;
+  const char *actLine = unit->code;
+  while (actLine != NULL && *actLine != '\0')
+  {
+    if (strncmp(actLine, "CALL ", 5) == 0)
+      util_markCalledUnits(util_findUnit(actLine + 5, strcspn(actLine + 5, " \n")));
+    actLine = strchr(actLine, '\n');
+    if (actLine != NULL)
+      actLine++;
+  }
+}
+
+// returns code of unit for inliner, units which are not expanded yet (recursion) are not offered
+const char *util_getUnitCode(const char *label, unsigned len)
+{
+  TCodeUnit unit = util_findUnit(label, len);
+  return (unit != NULL && unit->inlineState == 2) ? unit->code : NULL;
+}
+
+// expands calls of small functions in unit, called units are expanded first
+void util_inlineUnit(TCodeUnit unit)
+{
+  if (unit == NULL || unit->inlineState != 0 || unit->code == NULL)
+    return;
+  unit->inlineState = 1;
+  const char *actLine = unit->code;
+  while (actLine != NULL && *actLine != '\0')
+  {
+    if (strncmp(actLine, "CALL ", 5) == 0)
+      util_inlineUnit(util_findUnit(actLine + 5, strcspn(actLine + 5, " \n")));
+    actLine = strchr(actLine, '\n');
+    if (actLine != NULL)
+      actLine++;
+  }
+
+  char *code = inl_expandCalls(unit->code, util_getUnitCode);
+  if (code != NULL)
+  {
+    // label of unit stays on its beginning, rest of code is optimized again
+    char *body = strchr(code, '\n');
+    body = (body != NULL) ? body + 1 : code + strlen(code);
+    // labels of this pass must differ from labels generated when unit was flushed
+    char *labelPrefix = util_StrConcatenate(unit->label, "$inl");
+    char *laidOut = cfg_optimizeCode(body, labelPrefix);
+    mmng_safeFree(labelPrefix);
+    char *optimized = cprop_optimizeCode(laidOut, NULL, NULL);
+    mmng_safeFree(laidOut);
+    unsigned headLen = body - code;
+    unsigned optimizedLen = strlen(optimized);
+    mmng_safeFree(unit->code);
+    unit->len = headLen + optimizedLen;
+    unit->cap = unit->len + 1;
+    unit->code = mmng_safeMalloc(sizeof(char) * unit->cap);
+    memcpy(unit->code, code, headLen);
+    memcpy(unit->code + headLen, optimized, optimizedLen + 1);
+    mmng_safeFree(optimized);
+    mmng_safeFree(code);
+  }
+  unit->inlineState = 2;
+}
 
 void printInstruction(const char *arg, ...)
 {
@@ -45,9 +176,11 @@ void printInstruction(const char *arg, ...)
   }
   while (counter * 128 + arglen + arrPos + 1 > arrSize)
   {
-    arrSize += UTILS_ARR_CHUNK;
+    arrSize *= 2; // buffer of big function is not copied by every instruction
     Iarr = mmng_safeRealloc(Iarr, sizeof(char) * arrSize);
   }
+  if (deadCodeLevel > 0)
+    return;
   bool iscreateframe = strcmp(arg, "CREATEFRAME\n") == 0;
   if (!iscreateframe || !lastWasCreateFrame)
   {
@@ -56,8 +189,10 @@ void printInstruction(const char *arg, ...)
     // vfprintf(stderr, arg, ap);
     // va_end(ap);
     // va_start(ap, arg);
-    arrPos += vsprintf(&(Iarr[arrPos]), arg, ap);
+    unsigned printed = vsprintf(&(Iarr[arrPos]), arg, ap);
     va_end(ap);
+    arrPos += printed;
+    STATS_ADD(emittedBytes, printed);
   }
   lastWasCreateFrame = iscreateframe;
 }
@@ -74,11 +209,11 @@ void printLongInstruction(unsigned len, const char *arg, ...)
 
   unsigned arglen = strlen(arg);
 
-  if (arglen == 0)
+  if (arglen == 0 || deadCodeLevel > 0)
     return;
   while (len + arglen + arrPos + 1 > arrSize)
   {
-    arrSize += UTILS_ARR_CHUNK;
+    arrSize *= 2; // buffer of big function is not copied by every instruction
     Iarr = mmng_safeRealloc(Iarr, sizeof(char) * arrSize);
   }
 
@@ -87,19 +222,228 @@ void printLongInstruction(unsigned len, const char *arg, ...)
   // vfprintf(stderr, arg, ap);
   // va_end(ap);
   // va_start(ap, arg);
-  arrPos += vsprintf(&(Iarr[arrPos]), arg, ap);
+  unsigned printed = vsprintf(&(Iarr[arrPos]), arg, ap);
   va_end(ap);
+  arrPos += printed;
+  STATS_ADD(emittedBytes, printed);
 }
 
-void flushCode()
+void printDirectInstruction(const char *arg, ...)
+{
+  va_list ap;
+  va_start(ap, arg);
+  int len = vsnprintf(NULL, 0, arg, ap);
+  va_end(ap);
+  if (len <= 0)
+    return;
+  char *code = mmng_safeMalloc(sizeof(char) * (len + 1));
+  va_start(ap, arg);
+  vsnprintf(code, len + 1, arg, ap);
+  va_end(ap);
+  util_appendToUnit(code, len);
+  mmng_safeFree(code);
+  STATS_ADD(emittedBytes, len);
+}
+
+void util_beginCodeUnit(const char *label)
+{
+  if (unitCnt == unitCap)
+  {
+    unitCap += 16;
+    codeUnits = mmng_safeRealloc(codeUnits, sizeof(TCodeUnit) * unitCap);
+  }
+  TCodeUnit unit = mmng_safeMalloc(sizeof(struct CodeUnit));
+  unit->label = util_StrHardCopy(label);
+  unit->code = NULL;
+  unit->len = 0;
+  unit->cap = 0;
+  unit->isCalled = false;
+  unit->inlineState = 0;
+  codeUnits[unitCnt++] = unit;
+}
+
+void util_printUnitCode(const char *code, unsigned len)
+{
+  util_appendToUnit(code, len);
+}
+
+void util_printUnitCodeOf(const char *label, const char *code, unsigned len)
+{
+  TCodeUnit unit = util_findUnit(label, strlen(label));
+  if (unit == NULL)
+    apperr_runtimeError("util_printUnitCodeOf(): unit of label does not exist.");
+  util_appendCode(unit, code, len);
+}
+
+const char *util_actUnitCode(unsigned *len)
+{
+  if (unitCnt == 0)
+  {
+    *len = 0;
+    return "";
+  }
+  *len = codeUnits[unitCnt - 1]->len;
+  return (codeUnits[unitCnt - 1]->code != NULL) ? codeUnits[unitCnt - 1]->code : "";
+}
+
+// prints units to output and frees them, units of functions are printed only if they are called or isAll is true
+void util_outputUnits(bool isAll)
+{
+  for (unsigned i = 0; i < unitCnt; i++)
+  {
+    TCodeUnit unit = codeUnits[i];
+    if ((unit->label == NULL || unit->isCalled || isAll) && unit->code != NULL)
+      ctx_output(unit->code, unit->len);
+    if (unit->label != NULL)
+      mmng_safeFree(unit->label);
+    if (unit->code != NULL)
+      mmng_safeFree(unit->code);
+    mmng_safeFree(unit);
+  }
+  if (codeUnits != NULL)
+    mmng_safeFree(codeUnits);
+  codeUnits = NULL;
+  unitCnt = 0;
+  unitCap = 0;
+}
+
+void util_printCodeUnits(const char *entryLabel)
+{
+  STATS_BEGIN(start);
+  util_inlineUnit(util_findUnit(entryLabel, strlen(entryLabel)));
+  util_markCalledUnits(util_findUnit(entryLabel, strlen(entryLabel)));
+  util_outputUnits(false);
+  STATS_END(statsLink, start);
+}
+
+bool util_isBufferFull()
+{
+  return maxBuffer > 0 && arrPos >= maxBuffer && deadCodeLevel == 0;
+}
+
+bool util_isStreamed()
+{
+  return streamedCnt > 0;
+}
+
+void util_streamCode(const char *label, unsigned usedTemps, bool isEnd)
 {
+  // everything before body of main function is printed first, main function is not complete yet,
+  // so it is not known which functions it calls and all of them are printed, later units contain
+  // only code printed directly to main function (definitions of variables)
+  if (streamedCnt == 0)
+    for (unsigned i = 0; i < unitCnt; i++)
+      util_inlineUnit(codeUnits[i]);
+  util_outputUnits(true);
+  if (streamedCnt == 0)
+    ctx_output("CREATEFRAME\n", strlen("CREATEFRAME\n"));
+
+  // temporary variables used first time in this block
+  char def[32];
+  for (; streamedTemps < usedTemps; streamedTemps++)
+    ctx_output(def, sprintf(def, "DEFVAR TF@%%T%u\n", streamedTemps));
+
+  if (arrPos > 0)
+  {
+    STATS_BEGIN(start);
+    // labels of blocks are distinguished by number of block
+    char *prefix = mmng_safeMalloc(sizeof(char) * (strlen(label) + 16));
+    sprintf(prefix, "%s$b%u", label, streamedCnt);
+    char *laidOut = cfg_optimizeCode(Iarr, prefix);
+    mmng_safeFree(prefix);
+    unsigned removed = 0;
+    char *defs = NULL;
+    char *code = isEnd ? cprop_optimizeCode(laidOut, &defs, &removed) : cprop_optimizeBlock(laidOut, &defs, &removed);
+    mmng_safeFree(laidOut);
+    STATS_END(statsOptimize, start);
+    #ifdef DEBUG
+    fprintf(stderr, "Function %s block %u: copy propagation removed %u instructions\n", label, streamedCnt, removed);
+    #else
+    (void)removed;
+    #endif // DEBUG
+
+    // auxiliary variables are named from TF@%V0 in every block, variables of previous blocks are reused
+    const char *newDefs = defs;
+    for (unsigned i = 0; i < streamedVars && *newDefs != '\0'; i++)
+      newDefs = strchr(newDefs, '\n') + 1;
+    for (const char *def = newDefs; *def != '\0'; def = strchr(def, '\n') + 1)
+      streamedVars++;
+    ctx_output(newDefs, strlen(newDefs));
+    mmng_safeFree(defs);
+    ctx_output(code, strlen(code));
+    mmng_safeFree(code);
+  }
+
+  arrPos = 0;
   if (Iarr != NULL)
+    Iarr[0] = '\0';
+  streamedCnt++;
+}
+
+void util_deadCodeBegin()
+{
+  deadCodeLevel++;
+}
+
+void util_deadCodeEnd()
+{
+  if (deadCodeLevel > 0)
+    deadCodeLevel--;
+}
+
+bool util_isDeadCode()
+{
+  return deadCodeLevel > 0;
+}
+
+void flushCode()
+{
+  if (Iarr != NULL && arrPos > 0)
   {
-    printf("%s", Iarr);
+    STATS_BEGIN(start);
+    // buffer contains code of one function, its control flow is optimized as whole
+    const char *label = (unitCnt > 0 && codeUnits[unitCnt - 1]->label != NULL) ? codeUnits[unitCnt - 1]->label : "$";
+    char *laidOut = cfg_optimizeCode(Iarr, label);
+    unsigned removed = 0;
+    char *defs = NULL;
+    char *code = cprop_optimizeCode(laidOut, &defs, &removed);
+    mmng_safeFree(laidOut);
+    STATS_END(statsOptimize, start);
+    #ifdef DEBUG
+    fprintf(stderr, "Function %s: copy propagation removed %u instructions\n", label, removed);
+    #else
+    (void)removed;
+    #endif // DEBUG
+    // temporary frame of function is already created, new auxiliary variables are defined before body
+    util_appendToUnit(defs, strlen(defs));
+    mmng_safeFree(defs);
+    util_appendToUnit(code, strlen(code));
+    mmng_safeFree(code);
     arrPos = 0;
+    Iarr[0] = '\0';
   }
 }
 
+unsigned util_codePosition()
+{
+  return arrPos;
+}
+
+char *util_cutCode(unsigned position)
+{
+  if (position > arrPos)
+    position = arrPos;
+  unsigned len = arrPos - position;
+  char *code = mmng_safeMalloc(sizeof(char) * (len + 1));
+  if (len > 0)
+    memcpy(code, &(Iarr[position]), len);
+  code[len] = '\0';
+  arrPos = position;
+  if (Iarr != NULL)
+    Iarr[arrPos] = '\0';
+  return code;
+}
+
 // hard string copy
 char *util_StrHardCopy(const char *str)
 {
@@ -200,23 +544,27 @@ char *grammarToString(EGrSymb symb)
   return tokenTypeStrings[symb];
 }
 
-// Fuction prints build-in functions
+// Fuction prints build-in functions, every one as separate code unit
 void util_printBuildFunc()
 {
-  printf("LABEL $$Length\nPUSHFRAME\nDEFVAR LF@%%retval\nMOVE LF@%%retval int@0\nSTRLEN LF@%%retval LF@p1\nPOPFRAME\nRETURN\n");
+  util_beginCodeUnit("$$Length");
+  printDirectInstruction("LABEL $$Length\nPUSHFRAME\nDEFVAR LF@%%retval\nMOVE LF@%%retval int@0\nSTRLEN LF@%%retval LF@p1\nPOPFRAME\nRETURN\n");
 
-  printf("LABEL $$SubStr\nPUSHFRAME\nDEFVAR LF@%%retval\nDEFVAR LF@len\nDEFVAR LF@help\nSTRLEN LF@len LF@p1\nSUB LF@p2 LF@p2 int@1 \nMOVE LF@%%retval string@\n");
-  printf("JUMPIFEQ $$EndSubStr LF@%%retval LF@p1\nGT LF@help int@0 LF@p2\nJUMPIFEQ $$EndSubStr LF@help bool@true\nGT LF@help int@0 LF@p3\n");
-  printf("JUMPIFEQ $$SubStrExtra1 LF@help bool@true\nSUB LF@help LF@len LF@p2\nGT LF@help LF@p3 LF@help\nJUMPIFEQ $$SubStrExtra2 LF@help bool@true\n");
-  printf("JUMP $$SubStrStart\nLABEL $$SubStrExtra1\nSUB LF@p3 LF@len LF@p2\nJUMP $$CycleSubStr\nLABEL $$SubStrExtra2\nMOVE LF@p3 LF@len\n");
-  printf("SUB LF@p3 LF@p3 LF@p2\nLABEL $$SubStrStart\nADD LF@p3 LF@p2 LF@p3\nLABEL $$CycleSubStr\nGETCHAR LF@help LF@p1 LF@p2\n");
-  printf("CONCAT LF@%%retval LF@%%retval LF@help\nADD LF@p2 LF@p2 int@1\nJUMPIFNEQ $$CycleSubStr LF@p2 LF@p3\nLABEL $$EndSubStr\nPOPFRAME\nRETURN\n");
+  util_beginCodeUnit("$$SubStr");
+  printDirectInstruction("LABEL $$SubStr\nPUSHFRAME\nDEFVAR LF@%%retval\nDEFVAR LF@len\nDEFVAR LF@help\nSTRLEN LF@len LF@p1\nSUB LF@p2 LF@p2 int@1 \nMOVE LF@%%retval string@\n");
+  printDirectInstruction("JUMPIFEQ $$EndSubStr LF@%%retval LF@p1\nGT LF@help int@0 LF@p2\nJUMPIFEQ $$EndSubStr LF@help bool@true\nGT LF@help int@0 LF@p3\n");
+  printDirectInstruction("JUMPIFEQ $$SubStrExtra1 LF@help bool@true\nSUB LF@help LF@len LF@p2\nGT LF@help LF@p3 LF@help\nJUMPIFEQ $$SubStrExtra2 LF@help bool@true\n");
+  printDirectInstruction("JUMP $$SubStrStart\nLABEL $$SubStrExtra1\nSUB LF@p3 LF@len LF@p2\nJUMP $$CycleSubStr\nLABEL $$SubStrExtra2\nMOVE LF@p3 LF@len\n");
+  printDirectInstruction("SUB LF@p3 LF@p3 LF@p2\nLABEL $$SubStrStart\nADD LF@p3 LF@p2 LF@p3\nLABEL $$CycleSubStr\nGETCHAR LF@help LF@p1 LF@p2\n");
+  printDirectInstruction("CONCAT LF@%%retval LF@%%retval LF@help\nADD LF@p2 LF@p2 int@1\nJUMPIFNEQ $$CycleSubStr LF@p2 LF@p3\nLABEL $$EndSubStr\nPOPFRAME\nRETURN\n");
 
-  printf("LABEL $$Asc\nPUSHFRAME\nDEFVAR LF@%%retval\nSUB LF@p2 LF@p2 int@1 \nDEFVAR LF@help\nMOVE LF@%%retval int@0\nSTRLEN LF@help LF@p1\nGT LF@help LF@help LF@p2\n");
-  printf("JUMPIFEQ $$EndAsc LF@help bool@false\nGT LF@help int@0 LF@p2 \nJUMPIFEQ $$EndAsc LF@help bool@true \nGETCHAR LF@%%retval LF@p1 LF@p2\nSTRI2INT LF@%%retval LF@%%retval int@0\n");
-  printf("LABEL $$EndAsc\nPOPFRAME\nRETURN\n");
+  util_beginCodeUnit("$$Asc");
+  printDirectInstruction("LABEL $$Asc\nPUSHFRAME\nDEFVAR LF@%%retval\nSUB LF@p2 LF@p2 int@1 \nDEFVAR LF@help\nMOVE LF@%%retval int@0\nSTRLEN LF@help LF@p1\nGT LF@help LF@help LF@p2\n");
+  printDirectInstruction("JUMPIFEQ $$EndAsc LF@help bool@false\nGT LF@help int@0 LF@p2 \nJUMPIFEQ $$EndAsc LF@help bool@true \nGETCHAR LF@%%retval LF@p1 LF@p2\nSTRI2INT LF@%%retval LF@%%retval int@0\n");
+  printDirectInstruction("LABEL $$EndAsc\nPOPFRAME\nRETURN\n");
 
-  printf("LABEL $$Chr\nPUSHFRAME\nDEFVAR LF@%%retval\nMOVE LF@%%retval string@\nINT2CHAR LF@%%retval LF@p1\nPOPFRAME\nRETURN\n");
+  util_beginCodeUnit("$$Chr");
+  printDirectInstruction("LABEL $$Chr\nPUSHFRAME\nDEFVAR LF@%%retval\nMOVE LF@%%retval string@\nINT2CHAR LF@%%retval LF@p1\nPOPFRAME\nRETURN\n");
 }
 
 // true if string is buid-in function
@@ -34,6 +34,106 @@ void printLongInstruction(unsigned len, const char *arg, ...);
 
 void flushCode();
 
+/**
+ * Prints code which is not buffered and optimized (headers of functions, definitions of variables)
+ * right to actual code unit
+ */
+void printDirectInstruction(const char *, ...);
+
+/**
+ * Starts new code unit (code of function), all following code belongs to it
+ *
+ * \param label label of function, NULL for code which is printed always
+ */
+void util_beginCodeUnit(const char *label);
+
+/**
+ * Appends code right to actual code unit (code which was already generated and optimized)
+ *
+ * \param code code
+ * \param len length of code
+ */
+void util_printUnitCode(const char *code, unsigned len);
+
+/**
+ * Appends code right to code unit of function, which was started earlier
+ *
+ * \param label label of unit
+ * \param code code
+ * \param len length of code
+ */
+void util_printUnitCodeOf(const char *label, const char *code, unsigned len);
+
+/**
+ * Code of actual code unit (last started one)
+ *
+ * \param len returns length of code
+ * \returns code of unit, it is valid until more code is printed
+ */
+const char *util_actUnitCode(unsigned *len);
+
+/**
+ * Prints all code units reachable from unit of entry label by CALL instructions to standard output
+ * and frees them, code of functions which are never called is not printed at all.
+ * Before printing, calls of small functions are expanded inline (see inliner.h).
+ */
+void util_printCodeUnits(const char *entryLabel);
+
+/**
+ * True if buffered code exceeds limit of context (see ifjc_setMaxBuffer()) and it should be streamed
+ */
+bool util_isBufferFull();
+
+/**
+ * True if part of main function is already printed by util_streamCode()
+ */
+bool util_isStreamed();
+
+/**
+ * Prints buffered code of main function to output as separate block
+ *
+ * Buffered code has to be complete sequence of statements. Before first block, all code units
+ * are printed (functions are not filtered by calls) and temporary frame of main function is created.
+ *
+ * \param label label of main function
+ * \param usedTemps count of temporary variables used by main function until now
+ * \param isEnd true for last block of main function
+ */
+void util_streamCode(const char *label, unsigned usedTemps, bool isEnd);
+
+/**
+ * Actual position (length) of buffered code, it can be used later by util_cutCode()
+ */
+unsigned util_codePosition();
+
+/**
+ * Removes buffered code from position to the end of buffer and returns it
+ *
+ * Used when already generated code has to be rearranged, returned code can be printed again
+ * by printLongInstruction().
+ * \note Memory is allocated here and free has to be called.
+ */
+char *util_cutCode(unsigned position);
+
+/**
+ * Starts section of unreachable code
+ *
+ * Until matching util_deadCodeEnd() is called, printed instructions are thrown away.
+ * Sections can be nested.
+ * Dead code is still fully parsed and checked.
+ */
+void util_deadCodeBegin();
+
+/**
+ * Ends section of unreachable code started by util_deadCodeBegin()
+ */
+void util_deadCodeEnd();
+
+/**
+ * True if printed code is actually thrown away as unreachable
+ */
+bool util_isDeadCode();
+
 /**
  * Fuction create hard copy of given string
  * \note Memory is allocated here and free has to be called.
@@ -57,7 +157,7 @@ const char *util_dataTypeToString(const DataType dataType);
 char *grammarToString(EGrSymb symb);
 
 /**
- * Fuction prints build-in functions
+ * Fuction prints build-in functions, every function is separate code unit
  * \note These funcions are: Length, SubStr, Asc, Chr
  */
 void util_printBuildFunc();
@@ -0,0 +1,125 @@
+/******************************************************************************/
+/**
+ * \project IFJ-Compiler
+ * \file    client.c
+ * \brief   Client of compilation server
+ *
+ * Client sends source code from standard input to server (ifjcompile --serve <socket>), writes
+ * generated code to standard output, error messages to standard error output and exits with error
+ * code of compilation, so it can replace ifjcompile in scripts.
+ * With --bench <count> the source is compiled count times and latency of requests is reported.
+ *
+ * \author  Petr Fusek (xfusek08)
+ * \date    19.10.2026 - Petr Fusek
+ */
+/******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "Libs/server.h"
+#include "Libs/membuf.h"
+
+// prints usage of program
+void printUsage(const char *program)
+{
+  fprintf(stderr,
+    "Usage: %s <socket> [--bench <count>] < source > code\n"
+    "Options:\n"
+    "  --bench <count>  compile source count times and report latency of requests\n",
+    program);
+}
+
+// actual time in microseconds
+double nowUs()
+{
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1e6 + time.tv_nsec / 1e3;
+}
+
+int compareDouble(const void *a, const void *b)
+{
+  double diff = *(const double *)a - *(const double *)b;
+  return (diff > 0) - (diff < 0);
+}
+
+// compiles source count times and prints statistics of latency
+int bench(int fd, TMemBuf *src, unsigned count)
+{
+  TMemBuf code = { NULL, 0, 0 };
+  TMemBuf diagnostics = { NULL, 0, 0 };
+  double *latencies = mbuf_alloc(NULL, sizeof(double) * count);
+  double sum = 0;
+  int result = 0;
+  for (unsigned i = 0; i < count; i++)
+  {
+    double start = nowUs();
+    if (!server_compile(fd, src->data, src->len, &code, &diagnostics, &result))
+    {
+      fprintf(stderr, "communication with server failed\n");
+      return 99;
+    }
+    latencies[i] = nowUs() - start;
+    sum += latencies[i];
+  }
+  qsort(latencies, count, sizeof(double), compareDouble);
+  printf("requests: %u, result: %d, code: %u B\n", count, result, code.len);
+  printf("latency [us]: min %.1f, avg %.1f, p50 %.1f, p99 %.1f, max %.1f\n",
+    latencies[0], sum / count, latencies[count / 2], latencies[(count * 99) / 100], latencies[count - 1]);
+  free(latencies);
+  mbuf_free(&code);
+  mbuf_free(&diagnostics);
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned benchCnt = 0;
+  if (argc == 4 && strcmp(argv[2], "--bench") == 0)
+    benchCnt = strtoul(argv[3], NULL, 10);
+  if ((argc != 2 && argc != 4) || (argc == 4 && benchCnt == 0))
+  {
+    printUsage(argv[0]);
+    return 99;
+  }
+
+  TMemBuf src = { NULL, 0, 0 };
+  char chunk[4096];
+  size_t len;
+  mbuf_append(&src, "", 0);
+  while ((len = fread(chunk, sizeof(char), sizeof(chunk), stdin)) > 0)
+    mbuf_append(&src, chunk, len);
+
+  int fd = server_connect(argv[1]);
+  if (fd < 0)
+  {
+    fprintf(stderr, "%s: cannot connect to server\n", argv[1]);
+    return 99;
+  }
+
+  int result;
+  if (benchCnt > 0)
+    result = bench(fd, &src, benchCnt);
+  else
+  {
+    TMemBuf code = { NULL, 0, 0 };
+    TMemBuf diagnostics = { NULL, 0, 0 };
+    if (!server_compile(fd, src.data, src.len, &code, &diagnostics, &result))
+    {
+      fprintf(stderr, "communication with server failed\n");
+      result = 99;
+    }
+    fwrite(code.data, sizeof(char), code.len, stdout);
+    fwrite(diagnostics.data, sizeof(char), diagnostics.len, stderr);
+    mbuf_free(&code);
+    mbuf_free(&diagnostics);
+  }
+  close(fd);
+  mbuf_free(&src);
+  return result;
+}
@@ -11,26 +11,128 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <unistd.h>
-#include "Libs/mmng.h"
-#include "Libs/symtable.h"
-#include "Libs/rparser.h"
-#include "Libs/scanner.h"
-#include "Libs/syntaxanalyzer.h"
+#include "Libs/ifjc.h"
+#include "Libs/batch.h"
+#include "Libs/server.h"
+#include "Libs/cache.h"
+#include "Libs/membuf.h"
+
+// prints usage of program
+void printUsage(const char *program)
+{
+  fprintf(stderr,
+    "Usage: %s [options] < source > code\n"
+    "Options:\n"
+    "  --batch <list>   compile all sources of list (one \"source [output]\" per line)\n"
+    "  --jobs <count>   count of worker threads of batch or server (default is count of processors)\n"
+    "                   or of threads generating code of functions of one source\n"
+    "  --serve <socket> serve compilation requests on unix socket (client is ifjclient)\n"
+    "  --cache <dir>    reuse code of unchanged sources from cache directory\n"
+    "  --cache-size <MiB> limit of size of cache directory, default is 256\n"
+    "  --incremental <file> reuse code of unchanged functions kept in file\n"
+    "  --max-buffer <KiB> print code of main scope in blocks when its buffer exceeds limit\n"
+    "  --stats=json     print counters of compilation to standard error output (make stats)\n"
+    "  --full-teardown  free memory of compilation before exit (for leak checkers)\n",
+    program);
+}
+
+// writes report to file given as user data
+void writeFile(const char *data, unsigned len, void *userData)
+{
+  fwrite(data, sizeof(char), len, (FILE *)userData);
+}
+
+// compiles standard input to standard output
+int compileInput(TCompileCache cache, const char *incrementalPath, unsigned jobCnt, unsigned maxBuffer,
+  bool isStats, bool isFullTeardown)
+{
+  TCompilerCtx ctx = ifjc_createCtx();
+  if (ctx == NULL)
+  {
+    fprintf(stderr, "\033[31;1mInternal runtime error (99):\033[0m Allocation of compiler context failed.\n");
+    return 99;
+  }
+  ifjc_setMaxBuffer(ctx, maxBuffer);
+  // process exits after compilation, memory is freed at once by its end
+  ifjc_setExitTeardown(ctx, !isFullTeardown);
+  int result;
+  if (cache == NULL && incrementalPath == NULL && jobCnt <= 1)
+    result = ifjc_compile(ctx, NULL, 0, NULL, NULL);
+  else
+  {
+    // key of cache is hash of whole source, incremental compilation reads functions ahead and
+    // functions are generated in parallel from positions in source, so source is read before compilation
+    TMemBuf src = { NULL, 0, 0 };
+    char chunk[4096];
+    size_t len;
+    mbuf_append(&src, "", 0);
+    while ((len = fread(chunk, sizeof(char), sizeof(chunk), stdin)) > 0)
+      mbuf_append(&src, chunk, len);
+    ifjc_setIncremental(ctx, incrementalPath);
+    ifjc_setJobs(ctx, jobCnt);
+    result = cache_compile(cache, ctx, src.data, src.len, NULL, NULL);
+    mbuf_free(&src);
+  }
+  if (isStats && !ifjc_printStats(ctx, writeFile, stderr))
+    fprintf(stderr, "--stats=json: compiler is built without counters, build it by make stats\n");
+  ifjc_destroyCtx(ctx);
+  return result;
+}
 
 int main(int argc, char *argv[])
 {
-  (void)argc;
-  (void)argv;
+  const char *batchList = NULL;
+  const char *socketPath = NULL;
+  const char *cacheDir = NULL;
+  const char *incrementalPath = NULL;
+  unsigned long long cacheSize = CACHE_DEFAULT_SIZE;
+  unsigned jobCnt = 0;
+  unsigned maxBuffer = 0;
+  bool isStats = false;
+  bool isFullTeardown = false;
+  #ifdef __SANITIZE_ADDRESS__
+  isFullTeardown = true; // memory left to exit would be reported as leaks
+  #endif // __SANITIZE_ADDRESS__
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc)
+      batchList = argv[++i];
+    else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc)
+      jobCnt = strtoul(argv[++i], NULL, 10);
+    else if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc)
+      socketPath = argv[++i];
+    else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc)
+      cacheDir = argv[++i];
+    else if (strcmp(argv[i], "--cache-size") == 0 && i + 1 < argc)
+      cacheSize = strtoull(argv[++i], NULL, 10) * 1024ull * 1024ull;
+    else if (strcmp(argv[i], "--incremental") == 0 && i + 1 < argc)
+      incrementalPath = argv[++i];
+    else if (strcmp(argv[i], "--max-buffer") == 0 && i + 1 < argc)
+      maxBuffer = strtoul(argv[++i], NULL, 10) * 1024;
+    else if (strcmp(argv[i], "--stats=json") == 0)
+      isStats = true;
+    else if (strcmp(argv[i], "--full-teardown") == 0)
+      isFullTeardown = true;
+    else
+    {
+      printUsage(argv[0]);
+      return 99;
+    }
+  }
+
+  TCompileCache cache = NULL;
+  if (cacheDir != NULL && (cache = cache_open(cacheDir, cacheSize)) == NULL)
+    fprintf(stderr, "%s: cache directory cannot be used, compiling without cache\n", cacheDir);
 
-  mmng_init();
-  symbt_init("$$main");
-  scan_init();
-  syntx_init();
-  rparser_processProgram();
-  syntx_destroy();
-  scan_destroy();
-  symbt_destroy();
-  mmng_freeAll();
-  return 0;
+  int result;
+  if (socketPath != NULL)
+    result = server_run(socketPath, jobCnt, maxBuffer, cache);
+  else if (batchList != NULL)
+    result = batch_run(batchList, jobCnt, maxBuffer, cache);
+  else
+    result = compileInput(cache, incrementalPath, jobCnt, maxBuffer, isStats, isFullTeardown);
+  cache_close(cache);
+  return result;
 }